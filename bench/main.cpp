@@ -0,0 +1,171 @@
+#include <cstdint>
+#include <cstdio>
+
+#include <queue.hpp>
+#include <ringbuffer.hpp>
+
+using namespace r2d2;
+
+/**
+ * Micro-benchmarks for the containers in this library.
+ *
+ * Every benchmark prints one line in the fixed format
+ *
+ *     bench <name> <ops> <total> <per-op> <unit>
+ *
+ * so runs can be diffed or compared in CI. On the Arduino Due the
+ * numbers are CPU cycles measured with the DWT cycle counter; on
+ * the native target they are nanoseconds from std::chrono.
+ */
+
+#ifdef BMPTK_TARGET_arduino_due
+
+namespace {
+    constexpr char unit[] = "cycles";
+
+    void counter_init() {
+        // Enable the DWT cycle counter (DEMCR.TRCENA + DWT_CTRL.CYCCNTENA).
+        *reinterpret_cast<volatile uint32_t *>(0xE000EDFC) |= (1 << 24);
+        *reinterpret_cast<volatile uint32_t *>(0xE0001000) |= 1;
+    }
+
+    uint64_t counter_now() {
+        return *reinterpret_cast<volatile uint32_t *>(0xE0001004);
+    }
+}
+
+#else
+
+#include <chrono>
+
+namespace {
+    constexpr char unit[] = "ns";
+
+    void counter_init() {}
+
+    uint64_t counter_now() {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+}
+
+#endif
+
+namespace {
+    // Sink that keeps the optimizer from deleting the measured work.
+    volatile uint32_t sink = 0;
+
+    /**
+     * Time a body and print one result line.
+     *
+     * @param name
+     * @param ops
+     * @param body
+     */
+    template<typename Body>
+    void benchmark(const char *name, uint32_t ops, Body &&body) {
+        const uint64_t start = counter_now();
+
+        body();
+
+        const uint64_t total = counter_now() - start;
+
+        printf(
+            "bench %s %lu %lu %lu %s\n",
+            name,
+            static_cast<unsigned long>(ops),
+            static_cast<unsigned long>(total),
+            static_cast<unsigned long>(total / ops),
+            unit
+        );
+    }
+
+    /**
+     * Element payload of a given size, so the cost of the
+     * shifting/copying paths can be compared across sizes.
+     *
+     * @tparam Size
+     */
+    template<size_t Size>
+    struct payload_s {
+        uint8_t data[Size] = {};
+    };
+
+    constexpr uint32_t rounds = 1000;
+
+    /**
+     * Fill and drain a queue_c repeatedly.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Optimization
+     * @param name
+     */
+    template<typename T, size_t MaxSize, queue_optimization Optimization>
+    void bench_queue(const char *name) {
+        queue_c<T, MaxSize, Optimization> queue;
+
+        benchmark(name, rounds * MaxSize, [&queue]() {
+            for (uint32_t round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < MaxSize; i++) {
+                    queue.push(T());
+                }
+
+                while (!queue.empty()) {
+                    sink += 1;
+                    queue.copy_and_pop();
+                }
+            }
+        });
+    }
+
+    /**
+     * Fill and drain a ringbuffer_c repeatedly.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @param name
+     */
+    template<typename T, size_t MaxSize>
+    void bench_ringbuffer(const char *name) {
+        ringbuffer_c<T, MaxSize> buffer;
+
+        benchmark(name, rounds * MaxSize, [&buffer]() {
+            for (uint32_t round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < MaxSize; i++) {
+                    buffer.push(T());
+                }
+
+                while (!buffer.empty()) {
+                    sink += 1;
+                    buffer.copy_and_pop_front();
+                }
+            }
+        });
+    }
+}
+
+int main() {
+    counter_init();
+
+    bench_queue<uint8_t, 16, queue_optimization::WRITE>("queue_write_u8_16");
+    bench_queue<uint8_t, 256, queue_optimization::WRITE>("queue_write_u8_256");
+    bench_queue<uint8_t, 16, queue_optimization::READ>("queue_read_u8_16");
+    bench_queue<uint8_t, 256, queue_optimization::READ>("queue_read_u8_256");
+    bench_queue<uint8_t, 16, queue_optimization::BOTH>("queue_both_u8_16");
+    bench_queue<uint8_t, 256, queue_optimization::BOTH>("queue_both_u8_256");
+
+    bench_queue<payload_s<32>, 64, queue_optimization::WRITE>("queue_write_s32_64");
+    bench_queue<payload_s<32>, 64, queue_optimization::READ>("queue_read_s32_64");
+    bench_queue<payload_s<32>, 64, queue_optimization::BOTH>("queue_both_s32_64");
+
+    bench_ringbuffer<uint8_t, 16>("ringbuffer_u8_16");
+    bench_ringbuffer<uint8_t, 256>("ringbuffer_u8_256");
+
+    // Non-power-of-2 sizes pay a modulo on every index wrap.
+    bench_ringbuffer<uint8_t, 100>("ringbuffer_u8_100");
+    bench_ringbuffer<payload_s<32>, 64>("ringbuffer_s32_64");
+    bench_ringbuffer<payload_s<32>, 100>("ringbuffer_s32_100");
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+
+// This container is meant for the hosted (native) build
+// target; it is only compiled when the threading headers
+// are available.
+#if __has_include(<condition_variable>)
+
+#include <condition_variable>
+#include <mutex>
+
+#include "ringbuffer.hpp"
+
+namespace r2d2 {
+    /**
+     * Blocking wait-policy layer over ringbuffer_c for the
+     * hosted build.
+     *
+     * pop_wait() and push_wait() park the calling thread on
+     * a condition variable instead of spin- or sleep-polling
+     * empty()/full(), so an idle consumer costs no CPU and
+     * wakeup latency is a single notify rather than a poll
+     * interval.
+     *
+     * On the Due target there are no threads to block;
+     * interrupt-to-mainloop handover there should use
+     * spsc_ringbuffer_c and (if desired) WFE/WFI in the main
+     * loop instead.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class blocking_ringbuffer_c {
+    protected:
+        ringbuffer_c<T, MaxSize, ringbuffer_policy::REJECT> buffer;
+
+        mutable std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+
+    public:
+        /**
+         * Default constructor.
+         */
+        blocking_ringbuffer_c() = default;
+
+        blocking_ringbuffer_c(const blocking_ringbuffer_c &) = delete;
+        blocking_ringbuffer_c &operator=(const blocking_ringbuffer_c &) = delete;
+
+        /**
+         * Put an item in the ringbuffer, blocking while
+         * it is full.
+         *
+         * @param item
+         */
+        void push_wait(const T &item) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                not_full.wait(lock, [this] {
+                    return !buffer.full();
+                });
+
+                buffer.push(item);
+            }
+
+            not_empty.notify_one();
+        }
+
+        /**
+         * Get the first item from the ringbuffer and pop,
+         * blocking while it is empty.
+         *
+         * @return
+         */
+        T pop_wait() {
+            T item = [this] {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                not_empty.wait(lock, [this] {
+                    return !buffer.empty();
+                });
+
+                return buffer.copy_and_pop_front();
+            }();
+
+            not_full.notify_one();
+
+            return item;
+        }
+
+        /**
+         * Put an item in the ringbuffer without blocking.
+         *
+         * @param item
+         * @return whether the item was stored; false when full
+         */
+        bool try_push(const T &item) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (!buffer.push(item)) {
+                    return false;
+                }
+            }
+
+            not_empty.notify_one();
+
+            return true;
+        }
+
+        /**
+         * Get the first item from the ringbuffer and pop
+         * without blocking.
+         *
+         * @param item
+         * @return whether an item was popped; false when empty
+         */
+        bool try_pop(T &item) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (buffer.empty()) {
+                    return false;
+                }
+
+                item = buffer.copy_and_pop_front();
+            }
+
+            not_full.notify_one();
+
+            return true;
+        }
+
+        /**
+         * Get the current size of the ringbuffer.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            return buffer.size();
+        }
+
+        /**
+         * Return whether the ringbuffer is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            return buffer.empty();
+        }
+
+        /**
+         * Return whether the ringbuffer is full.
+         *
+         * @return
+         */
+        bool full() const {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            return buffer.full();
+        }
+
+        /**
+         * Get the maximum size of the ringbuffer.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
+
+#endif
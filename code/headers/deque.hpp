@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "storage.hpp"
+
+namespace r2d2 {
+    /**
+     * Fixed-capacity double-ended queue.
+     *
+     * Uses circular head/count indices over a storage_c
+     * (like the BOTH optimization mode of queue_c), so
+     * pushing and popping at either end is O(1) with no
+     * element shifting. Useful for work-stealing style
+     * scheduling and sliding-window algorithms that trim
+     * both ends.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class deque_c {
+    protected:
+        storage_c<T, MaxSize> buffer;
+
+        // Physical index of the front element.
+        size_t head = 0;
+
+        // Element count.
+        size_t index = 0;
+
+    public:
+        /**
+         * Put an item at the back; dropped
+         * when the deque is full.
+         *
+         * @param item
+         */
+        void push_back(const T &item) {
+            // Checked before the write: a push on a full
+            // deque is a defined drop instead of silently
+            // overwriting the front.
+            if (full()) {
+                return;
+            }
+
+            buffer.set((head + index) % MaxSize, item);
+            index += 1;
+        }
+
+        /**
+         * Put an item at the back, moving instead of
+         * copying it; dropped when the deque is full.
+         *
+         * @param item
+         */
+        void push_back(T &&item) {
+            if (full()) {
+                return;
+            }
+
+            buffer.set((head + index) % MaxSize, std::move(item));
+            index += 1;
+        }
+
+        /**
+         * Put an item at the front; dropped
+         * when the deque is full.
+         *
+         * @param item
+         */
+        void push_front(const T &item) {
+            if (full()) {
+                return;
+            }
+
+            head = (head + MaxSize - 1) % MaxSize;
+            buffer.set(head, item);
+            index += 1;
+        }
+
+        /**
+         * Put an item at the front, moving instead of
+         * copying it; dropped when the deque is full.
+         *
+         * @param item
+         */
+        void push_front(T &&item) {
+            if (full()) {
+                return;
+            }
+
+            head = (head + MaxSize - 1) % MaxSize;
+            buffer.set(head, std::move(item));
+            index += 1;
+        }
+
+        /**
+         * Pop the item at the front.
+         */
+        void pop_front() {
+            buffer.destroy(head);
+            head = (head + 1) % MaxSize;
+            index -= 1;
+        }
+
+        /**
+         * Pop the item at the back.
+         */
+        void pop_back() {
+            index -= 1;
+            buffer.destroy((head + index) % MaxSize);
+        }
+
+        /**
+         * Get the item at the front and pop.
+         */
+        T copy_and_pop_front() {
+            T item = std::move(front());
+            pop_front();
+
+            return item;
+        }
+
+        /**
+         * Get the item at the back and pop.
+         */
+        T copy_and_pop_back() {
+            T item = std::move(back());
+            pop_back();
+
+            return item;
+        }
+
+        /**
+         * Get the item at the front.
+         */
+        T &front() {
+            return buffer[head];
+        }
+
+        /**
+         * Get the item at the front.
+         */
+        T const &front() const {
+            return buffer[head];
+        }
+
+        /**
+         * Get the item at the back.
+         */
+        T &back() {
+            return buffer[(head + index - 1) % MaxSize];
+        }
+
+        /**
+         * Get the item at the back.
+         */
+        T const &back() const {
+            return buffer[(head + index - 1) % MaxSize];
+        }
+
+        /**
+         * Get the item at the given index, front first.
+         *
+         * @param position
+         * @return
+         */
+        T &operator[](const size_t position) {
+            return buffer[(head + position) % MaxSize];
+        }
+
+        /**
+         * Get the item at the given index, front first.
+         *
+         * @param position
+         * @return
+         */
+        T const &operator[](const size_t position) const {
+            return buffer[(head + position) % MaxSize];
+        }
+
+        /**
+         * Clears the deque.
+         */
+        void clear() {
+            buffer.destroy_all();
+
+            head = 0;
+            index = 0;
+        }
+
+        /**
+         * Get the current size of the deque.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return index;
+        }
+
+        /**
+         * Is the deque empty?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Is the deque full?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Get the maximum size of the deque.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "ringbuffer.hpp"
+
+namespace r2d2 {
+    /**
+     * Double ("ping-pong") buffer for tear-free snapshots
+     * of in-flight data.
+     *
+     * One ringbuffer side is owned by the writer (e.g. a
+     * sampling interrupt) while the other is an immutable
+     * snapshot for the reader. The reader calls swap() when
+     * it is done with its side: the old snapshot is cleared,
+     * becomes the new write side and the buffer written so
+     * far becomes the new snapshot. The flip itself is a
+     * single atomic store, so the writer never stalls.
+     *
+     * Like spsc_ringbuffer_c this assumes one writer and one
+     * reader (the ISR-to-mainloop pattern); swap() must only
+     * be called by the reader.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class double_buffer_c {
+    protected:
+        ringbuffer_c<T, MaxSize> buffers[2];
+
+        // Index of the buffer the writer owns.
+        std::atomic<size_t> write_index = {0};
+
+    public:
+        /**
+         * Default constructor.
+         */
+        double_buffer_c() = default;
+
+        /**
+         * Get the buffer the writer may push into.
+         *
+         * @return
+         */
+        ringbuffer_c<T, MaxSize> &write() {
+            return buffers[write_index.load(std::memory_order_relaxed)];
+        }
+
+        /**
+         * Get the snapshot buffer for the reader.
+         *
+         * @return
+         */
+        const ringbuffer_c<T, MaxSize> &read() const {
+            return buffers[1 - write_index.load(std::memory_order_acquire)];
+        }
+
+        /**
+         * Flip the writer and reader sides.
+         *
+         * The old snapshot is reset and handed to the
+         * writer; everything written up to the flip becomes
+         * the new snapshot.
+         */
+        void swap() {
+            const size_t index = write_index.load(std::memory_order_relaxed);
+
+            // The reader is done with its side, so it can be
+            // cleared before the writer takes it over.
+            buffers[1 - index].reset();
+            write_index.store(1 - index, std::memory_order_release);
+        }
+
+        /**
+         * Get the maximum size of each side.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
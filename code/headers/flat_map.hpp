@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "storage.hpp"
+
+namespace r2d2 {
+    /**
+     * Fixed-capacity associative container storing its
+     * key/value pairs in sorted inline arrays (the same
+     * no-heap model as queue_c), so lookup is an O(log n)
+     * binary search instead of the O(n) scans consumers of
+     * this library currently write by hand.
+     *
+     * Insert and erase shift the tail of the arrays and are
+     * O(n); this trade-off fits registration-style maps that
+     * are built once and looked up on every frame.
+     *
+     * @tparam Key
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename Key, typename T, size_t MaxSize>
+    class flat_map_c {
+    protected:
+        storage_c<Key, MaxSize> keys;
+        storage_c<T, MaxSize> values;
+        size_t index = 0;
+
+        /**
+         * Get the position of the first key that is
+         * not less than the given key.
+         *
+         * @param key
+         * @return size_t
+         */
+        size_t lower_bound(const Key &key) const {
+            size_t low = 0;
+            size_t high = index;
+
+            while (low < high) {
+                const size_t middle = low + (high - low) / 2;
+
+                if (keys[middle] < key) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+
+            return low;
+        }
+
+    public:
+        /**
+         * Insert a value under the given key, or update
+         * the stored value when the key already exists.
+         *
+         * @param key
+         * @param value
+         * @return whether the value was stored; false when full
+         */
+        bool insert(const Key &key, const T &value) {
+            const size_t pos = lower_bound(key);
+
+            if (pos < index && !(key < keys[pos])) {
+                values.set(pos, value);
+                return true;
+            }
+
+            if (full()) {
+                return false;
+            }
+
+            // Shift the tail up to make room.
+            for (size_t i = index; i > pos; i--) {
+                keys.set(i, std::move(keys[i - 1]));
+                values.set(i, std::move(values[i - 1]));
+            }
+
+            keys.set(pos, key);
+            values.set(pos, value);
+            index += 1;
+
+            return true;
+        }
+
+        /**
+         * Find the value stored under the given key.
+         *
+         * @param key
+         * @return nullptr when the key is not present
+         */
+        T *find(const Key &key) {
+            const size_t pos = lower_bound(key);
+
+            if (pos < index && !(key < keys[pos])) {
+                return &values[pos];
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * Find the value stored under the given key.
+         *
+         * @param key
+         * @return nullptr when the key is not present
+         */
+        const T *find(const Key &key) const {
+            const size_t pos = lower_bound(key);
+
+            if (pos < index && !(key < keys[pos])) {
+                return &values[pos];
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * Is a value stored under the given key?
+         *
+         * @param key
+         * @return
+         */
+        bool contains(const Key &key) const {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * Remove the value stored under the given key.
+         *
+         * @param key
+         * @return whether the key was present
+         */
+        bool erase(const Key &key) {
+            const size_t pos = lower_bound(key);
+
+            if (pos >= index || key < keys[pos]) {
+                return false;
+            }
+
+            // Shift the tail down over the removed pair.
+            for (size_t i = pos + 1; i < index; i++) {
+                keys.set(i - 1, std::move(keys[i]));
+                values.set(i - 1, std::move(values[i]));
+            }
+
+            index -= 1;
+            keys.destroy(index);
+            values.destroy(index);
+
+            return true;
+        }
+
+        /**
+         * Clears the map.
+         */
+        void clear() {
+            keys.destroy_all();
+            values.destroy_all();
+
+            index = 0;
+        }
+
+        /**
+         * Get the current size of the map.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return index;
+        }
+
+        /**
+         * Is the map empty?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Is the map full?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Get the maximum size of the map.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
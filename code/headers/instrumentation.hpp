@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+
+namespace r2d2 {
+    /**
+     * Occupancy and traffic counters for an instrumented
+     * container, e.g. to dump over a debug UART when tuning
+     * a MaxSize.
+     */
+    struct container_statistics_s {
+        // Highest occupancy ever observed.
+        size_t high_watermark = 0;
+
+        // Total completed pushes and pops.
+        size_t pushes = 0;
+        size_t pops = 0;
+
+        // Pushes that hit a full container and pops
+        // that hit an empty one.
+        size_t overflows = 0;
+        size_t underflows = 0;
+    };
+
+    /**
+     * Statistics-keeping base for the containers; the
+     * uninstrumented specialization below is empty so it
+     * costs nothing (empty base optimization) when the
+     * Instrumented flag is off.
+     *
+     * @tparam Instrumented
+     */
+    template<bool Instrumented>
+    class instrumentation_c {
+    protected:
+        container_statistics_s stats;
+
+        /**
+         * Count completed pushes and track the
+         * high watermark.
+         *
+         * @param count
+         * @param occupancy
+         */
+        void count_pushes(size_t count, size_t occupancy) {
+            stats.pushes += count;
+
+            if (occupancy > stats.high_watermark) {
+                stats.high_watermark = occupancy;
+            }
+        }
+
+        /**
+         * Count completed pops.
+         *
+         * @param count
+         */
+        void count_pops(size_t count) {
+            stats.pops += count;
+        }
+
+        /**
+         * Count pushes that hit a full container.
+         *
+         * @param count
+         */
+        void count_overflows(size_t count) {
+            stats.overflows += count;
+        }
+
+        /**
+         * Count pops that hit an empty container.
+         */
+        void count_underflow() {
+            stats.underflows += 1;
+        }
+
+    public:
+        /**
+         * Get the collected statistics.
+         *
+         * @return
+         */
+        const container_statistics_s &statistics() const {
+            return stats;
+        }
+    };
+
+    template<>
+    class instrumentation_c<false> {
+    protected:
+        void count_pushes(size_t, size_t) {}
+        void count_pops(size_t) {}
+        void count_overflows(size_t) {}
+        void count_underflow() {}
+    };
+}
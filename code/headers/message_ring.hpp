@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ringbuffer.hpp"
+
+namespace r2d2 {
+    /**
+     * Byte ring for variable-length, length-prefixed
+     * messages (e.g. UART frames).
+     *
+     * Unlike a queue_c of fixed frame structs, memory scales
+     * with the actual bytes stored instead of the worst-case
+     * frame size: each message costs its own length plus one
+     * prefix byte. A push is a single bounded memcpy and
+     * front() hands out a zero-copy pointer into the ring.
+     *
+     * Messages are kept contiguous: when a message does not
+     * fit before the physical end of the buffer, the
+     * remaining bytes are marked as padding (a zero length
+     * prefix) and the message starts at the beginning
+     * instead, so front() never has to reassemble a split
+     * frame.
+     *
+     * The length prefix is one byte, so a message is
+     * limited to 255 bytes.
+     *
+     * @tparam MaxBytes
+     */
+    template<size_t MaxBytes>
+    class message_ring_c {
+    protected:
+        uint8_t buffer[MaxBytes] = {};
+
+        size_t head = 0;
+        size_t tail = 0;
+
+        // Stored bytes, including prefixes and padding.
+        size_t used = 0;
+
+        // Stored messages.
+        size_t count = 0;
+
+        /**
+         * Advance head past end-of-buffer padding, so it
+         * points at the prefix of the oldest message.
+         */
+        void skip_padding() {
+            if (count > 0 && buffer[head] == 0) {
+                used -= MaxBytes - head;
+                head = 0;
+            }
+        }
+
+    public:
+        /**
+         * Add a message to the ring.
+         *
+         * @param data
+         * @param length
+         * @return whether the message was stored; false when
+         *         it does not fit or the length is invalid
+         */
+        bool push(const uint8_t *data, const size_t length) {
+            if (length == 0 || length > 255 || length + 1 > MaxBytes) {
+                return false;
+            }
+
+            size_t needed = length + 1;
+
+            // Bytes that become padding when the message
+            // does not fit before the physical end.
+            size_t padding = 0;
+
+            if (tail + needed > MaxBytes) {
+                padding = MaxBytes - tail;
+            }
+
+            if (used + padding + needed > MaxBytes) {
+                return false;
+            }
+
+            if (padding > 0) {
+                // A zero prefix marks the rest of the
+                // buffer as padding.
+                buffer[tail] = 0;
+
+                used += padding;
+                tail = 0;
+            }
+
+            buffer[tail] = static_cast<uint8_t>(length);
+            memcpy(&buffer[tail + 1], data, length);
+
+            tail += needed;
+            if (tail == MaxBytes) {
+                tail = 0;
+            }
+
+            used += needed;
+            count += 1;
+
+            return true;
+        }
+
+        /**
+         * Get a zero-copy view of the oldest message.
+         *
+         * The segment stays valid until the message
+         * is popped.
+         *
+         * @return pointer and length; a nullptr segment
+         *         when the ring is empty
+         */
+        buffer_segment_s<const uint8_t> front() {
+            if (count == 0) {
+                return {nullptr, 0};
+            }
+
+            skip_padding();
+
+            return {&buffer[head + 1], buffer[head]};
+        }
+
+        /**
+         * Pop the oldest message.
+         */
+        void pop() {
+            if (count == 0) {
+                return;
+            }
+
+            skip_padding();
+
+            const size_t needed = buffer[head] + 1u;
+
+            head += needed;
+            if (head == MaxBytes) {
+                head = 0;
+            }
+
+            used -= needed;
+            count -= 1;
+        }
+
+        /**
+         * Get the oldest message into the given destination
+         * and pop.
+         *
+         * @param dest destination of at least front().size bytes
+         * @return the number of bytes copied
+         */
+        size_t copy_and_pop(uint8_t *dest) {
+            const auto segment = front();
+
+            if (segment.size == 0) {
+                return 0;
+            }
+
+            memcpy(dest, segment.data, segment.size);
+            pop();
+
+            return segment.size;
+        }
+
+        /**
+         * Reset (empty) the ring.
+         */
+        void reset() {
+            head = 0;
+            tail = 0;
+            used = 0;
+            count = 0;
+        }
+
+        /**
+         * Get the number of stored messages.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return count;
+        }
+
+        /**
+         * Get the number of used bytes, including prefixes
+         * and padding.
+         *
+         * @return size_t
+         */
+        size_t used_bytes() const {
+            return used;
+        }
+
+        /**
+         * Return whether the ring is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            return count == 0;
+        }
+
+        /**
+         * Get the capacity of the ring in bytes.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxBytes;
+        }
+    };
+}
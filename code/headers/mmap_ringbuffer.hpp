@@ -0,0 +1,329 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// This container is meant for the hosted (native) build
+// target; it is only compiled when the POSIX mmap headers
+// are available.
+#if __has_include(<sys/mman.h>)
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace r2d2 {
+    /**
+     * Ringbuffer whose storage and indices live in a
+     * memory-mapped file, for crash-surviving telemetry on
+     * the native target.
+     *
+     * Pushes are plain memory writes into the mapping, so
+     * records persist at memory speed without a syscall per
+     * record; the kernel writes the pages back and they
+     * survive process death. A file written by one run can
+     * be reopened later (by the recorder or an analysis
+     * tool) and read back without a serialization pass.
+     *
+     * On-disk layout: a file_header_s (magic, layout
+     * version, element size, capacity, head/tail/used),
+     * followed by capacity elements. open() refuses a file
+     * whose header does not match the instantiation.
+     *
+     * The index and wrap logic matches ringbuffer_c with the
+     * OVERWRITE policy; the element is written before the
+     * indices, so a crash mid-push loses at most the record
+     * being written. T has to be trivially copyable, as the
+     * elements are reinterpreted from the mapping.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class mmap_ringbuffer_c {
+    public:
+        /**
+         * Header at the start of the backing file.
+         */
+        struct file_header_s {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t element_size;
+            uint32_t capacity;
+            uint64_t head;
+            uint64_t tail;
+            uint64_t used;
+        };
+
+        // "r2rb" little-endian.
+        static constexpr uint32_t file_magic = 0x62723272;
+        static constexpr uint32_t file_version = 1;
+
+    protected:
+        static_assert(
+            std::is_trivially_copyable_v<T>,
+            "a mmap_ringbuffer_c needs a trivially copyable T"
+        );
+
+        static constexpr bool is_power_of_two = (MaxSize & (MaxSize - 1)) == 0;
+
+        static constexpr size_t file_size
+            = sizeof(file_header_s) + MaxSize * sizeof(T);
+
+        file_header_s *header = nullptr;
+        T *items = nullptr;
+        int descriptor = -1;
+
+        /**
+         * Wrap an index to the buffer boundary, masking
+         * instead of dividing when MaxSize allows it.
+         *
+         * @param index
+         * @return constexpr size_t
+         */
+        static constexpr size_t wrap(size_t index) {
+            if constexpr (is_power_of_two) {
+                return index & (MaxSize - 1);
+            } else {
+                return index % MaxSize;
+            }
+        }
+
+    public:
+        /**
+         * Default constructor; call open() before use.
+         */
+        mmap_ringbuffer_c() = default;
+
+        mmap_ringbuffer_c(const mmap_ringbuffer_c &) = delete;
+        mmap_ringbuffer_c &operator=(const mmap_ringbuffer_c &) = delete;
+
+        ~mmap_ringbuffer_c() {
+            close();
+        }
+
+        /**
+         * Open (or create) the backing file and map it.
+         *
+         * A new or empty file is initialized; an existing
+         * one is validated against this instantiation and
+         * its contents become readable again.
+         *
+         * @param path
+         * @return whether the file was opened and mapped
+         */
+        bool open(const char *path) {
+            close();
+
+            descriptor = ::open(path, O_RDWR | O_CREAT, 0644);
+            if (descriptor < 0) {
+                return false;
+            }
+
+            struct stat status = {};
+            if (fstat(descriptor, &status) < 0) {
+                close();
+                return false;
+            }
+
+            const bool fresh = status.st_size == 0;
+
+            if (fresh && ftruncate(descriptor, file_size) < 0) {
+                close();
+                return false;
+            }
+
+            if (!fresh && status.st_size != static_cast<off_t>(file_size)) {
+                close();
+                return false;
+            }
+
+            void *mapping = mmap(
+                nullptr, file_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, descriptor, 0
+            );
+
+            if (mapping == MAP_FAILED) {
+                close();
+                return false;
+            }
+
+            header = static_cast<file_header_s *>(mapping);
+            items = reinterpret_cast<T *>(
+                static_cast<uint8_t *>(mapping) + sizeof(file_header_s)
+            );
+
+            if (fresh) {
+                *header = {
+                    file_magic, file_version,
+                    sizeof(T), MaxSize,
+                    0, 0, 0
+                };
+            } else if (header->magic != file_magic
+                       || header->version != file_version
+                       || header->element_size != sizeof(T)
+                       || header->capacity != MaxSize
+                       || header->used > MaxSize) {
+                close();
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * Unmap and close the backing file.
+         */
+        void close() {
+            if (header != nullptr) {
+                munmap(header, file_size);
+
+                header = nullptr;
+                items = nullptr;
+            }
+
+            if (descriptor >= 0) {
+                ::close(descriptor);
+                descriptor = -1;
+            }
+        }
+
+        /**
+         * Is a backing file open?
+         *
+         * @return
+         */
+        bool is_open() const {
+            return header != nullptr;
+        }
+
+        /**
+         * Ask the kernel to write the mapping back to disk
+         * now, e.g. before a planned shutdown. Not needed
+         * for crash safety of already-written records.
+         *
+         * @return whether the sync succeeded
+         */
+        bool sync() {
+            return is_open() && msync(header, file_size, MS_SYNC) == 0;
+        }
+
+        /**
+         * Add a record, overwriting the oldest one when
+         * full.
+         *
+         * @param val
+         * @return
+         */
+        T &push(const T &val) {
+            const size_t position = wrap(header->tail);
+
+            // The record is written before the indices, so
+            // a crash between the two loses only this push.
+            items[position] = val;
+
+            header->tail = wrap(header->tail + 1);
+
+            if (full()) {
+                header->head = wrap(header->head + 1);
+            } else {
+                header->used += 1;
+            }
+
+            return items[position];
+        }
+
+        /**
+         * Copy the oldest record and pop; a
+         * value-initialized record when empty.
+         *
+         * @return
+         */
+        T copy_and_pop_front() {
+            // Checked before the header update: an
+            // underflowed used count would persist and make
+            // open() reject the file forever after.
+            if (empty()) {
+                return T{};
+            }
+
+            T item = items[header->head];
+
+            header->head = wrap(header->head + 1);
+            header->used -= 1;
+
+            return item;
+        }
+
+        /**
+         * Get the record at the given index, oldest first.
+         *
+         * @param index
+         * @return
+         */
+        T &operator[](const size_t index) {
+            return items[wrap(header->head + index)];
+        }
+
+        /**
+         * Get the record at the given index, oldest first.
+         *
+         * @param index
+         * @return
+         */
+        T const &operator[](const size_t index) const {
+            return items[wrap(header->head + index)];
+        }
+
+        /**
+         * Reset (empty) the ringbuffer.
+         */
+        void reset() {
+            header->head = 0;
+            header->tail = 0;
+            header->used = 0;
+        }
+
+        /**
+         * Get the current size of the ringbuffer.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return header->used;
+        }
+
+        /**
+         * Return whether the ringbuffer is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Return whether the ringbuffer is full.
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == MaxSize;
+        }
+
+        /**
+         * Get the maximum size of the ringbuffer.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+// This container is meant for the hosted (native) build
+// target; it is only compiled when <atomic> is available.
+#if __has_include(<atomic>)
+
+#include <atomic>
+
+namespace r2d2 {
+    /**
+     * Bounded lock-free multi-producer multi-consumer queue
+     * over the same fixed-storage model as queue_c.
+     *
+     * Every slot carries a sequence number that tells
+     * producers and consumers whether the slot is ready for
+     * them (Vyukov's bounded MPMC design), so any number of
+     * threads can push and pop with a compare-and-swap each
+     * instead of a shared lock.
+     *
+     * push and copy_and_pop return false when the queue is
+     * full respectively empty.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class mpmc_queue_c {
+    protected:
+        static_assert(
+            (MaxSize & (MaxSize - 1)) == 0,
+            "MaxSize of a mpmc_queue_c has to be a power of 2"
+        );
+
+        struct cell_s {
+            std::atomic<size_t> sequence;
+            T item;
+        };
+
+        cell_s buffer[MaxSize];
+
+        // The producer and consumer positions get their own
+        // cache lines so they don't false-share.
+        alignas(64) std::atomic<size_t> enqueue_position;
+        alignas(64) std::atomic<size_t> dequeue_position;
+
+    public:
+        /**
+         * Default constructor.
+         */
+        mpmc_queue_c() : enqueue_position(0), dequeue_position(0) {
+            for (size_t i = 0; i < MaxSize; i++) {
+                buffer[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpmc_queue_c(const mpmc_queue_c &) = delete;
+        mpmc_queue_c &operator=(const mpmc_queue_c &) = delete;
+
+        /**
+         * Put an item on the queue.
+         *
+         * @param item
+         * @return whether the item was stored; false when full
+         */
+        bool push(const T &item) {
+            size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+            for (;;) {
+                cell_s &cell = buffer[position & (MaxSize - 1)];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+                // Signed difference so position wraparound is handled.
+                const auto difference
+                    = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+
+                if (difference == 0) {
+                    // The slot is free; try to claim it.
+                    if (enqueue_position.compare_exchange_weak(
+                            position, position + 1, std::memory_order_relaxed)) {
+                        cell.item = item;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    // The slot still holds an unconsumed item.
+                    return false;
+                } else {
+                    position = enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Get the next item from the queue and pop.
+         *
+         * @param item
+         * @return whether an item was popped; false when empty
+         */
+        bool copy_and_pop(T &item) {
+            size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+            for (;;) {
+                cell_s &cell = buffer[position & (MaxSize - 1)];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+                // Signed difference so position wraparound is handled.
+                const auto difference = static_cast<ptrdiff_t>(sequence)
+                    - static_cast<ptrdiff_t>(position + 1);
+
+                if (difference == 0) {
+                    // The slot holds an item; try to claim it.
+                    if (dequeue_position.compare_exchange_weak(
+                            position, position + 1, std::memory_order_relaxed)) {
+                        item = std::move(cell.item);
+                        cell.sequence.store(
+                            position + MaxSize, std::memory_order_release
+                        );
+
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = dequeue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Get the current size of the queue.
+         *
+         * Only an estimate while other threads are
+         * pushing or popping.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return enqueue_position.load(std::memory_order_relaxed)
+                - dequeue_position.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Is the queue empty?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Is the queue full?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Get the maximum size of the queue.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace r2d2 {
+    /**
+     * Fixed-capacity object pool with an intrusive free
+     * list, so both acquire and release are O(1) and no
+     * heap is involved.
+     *
+     * Free slots store the next-pointer inside the slot
+     * itself; objects are constructed in place on acquire
+     * and destroyed on release, which lets modules pass
+     * pooled pointers around instead of copying objects
+     * through queues.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class pool_c {
+    protected:
+        struct slot_s {
+            union {
+                // Next free slot; only valid while
+                // the slot is not acquired.
+                slot_s *next;
+
+                alignas(T) unsigned char storage[sizeof(T)];
+            };
+        };
+
+        slot_s slots[MaxSize];
+        slot_s *free_list = nullptr;
+        size_t used = 0;
+
+    public:
+        /**
+         * Default constructor; links all
+         * slots into the free list.
+         */
+        pool_c() {
+            for (size_t i = 0; i < MaxSize - 1; i++) {
+                slots[i].next = &slots[i + 1];
+            }
+
+            slots[MaxSize - 1].next = nullptr;
+            free_list = &slots[0];
+        }
+
+        pool_c(const pool_c &) = delete;
+        pool_c &operator=(const pool_c &) = delete;
+
+        /**
+         * Take a slot from the pool and construct
+         * an item in it.
+         *
+         * @tparam Args
+         * @param args
+         * @return the item, or nullptr when the pool is exhausted
+         */
+        template<typename ...Args>
+        T *acquire(Args&& ...args) {
+            if (free_list == nullptr) {
+                return nullptr;
+            }
+
+            slot_s *slot = free_list;
+            free_list = slot->next;
+            used += 1;
+
+            return new (slot->storage) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Destroy an item acquired from this pool
+         * and return its slot to the free list.
+         *
+         * @param item
+         */
+        void release(T *item) {
+            item->~T();
+
+            auto *slot = reinterpret_cast<slot_s *>(item);
+            slot->next = free_list;
+            free_list = slot;
+            used -= 1;
+        }
+
+        /**
+         * Get the number of acquired slots.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return used;
+        }
+
+        /**
+         * Are all slots free?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Are all slots acquired?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Get the maximum size of the pool.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
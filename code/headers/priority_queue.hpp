@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace r2d2 {
+    /**
+     * Fixed-capacity priority queue implemented as an
+     * implicit binary heap, so push and pop are O(log n)
+     * without any allocation.
+     *
+     * With the default comparator front() is the smallest
+     * item (e.g. the nearest deadline); supply a different
+     * Compare to change the ordering.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Compare
+     */
+    template<typename T, size_t MaxSize, typename Compare = std::less<T>>
+    class priority_queue_c {
+    protected:
+        T buffer[MaxSize] = {};
+        size_t index = 0;
+        Compare compare = {};
+
+        /**
+         * Move the item at the given position up
+         * until the heap property holds again.
+         *
+         * @param pos
+         */
+        void sift_up(size_t pos) {
+            while (pos != 0) {
+                const size_t parent = (pos - 1) / 2;
+
+                if (!compare(buffer[pos], buffer[parent])) {
+                    break;
+                }
+
+                std::swap(buffer[pos], buffer[parent]);
+                pos = parent;
+            }
+        }
+
+        /**
+         * Move the item at the given position down
+         * until the heap property holds again.
+         *
+         * @param pos
+         */
+        void sift_down(size_t pos) {
+            for (;;) {
+                size_t smallest = pos;
+                const size_t left = 2 * pos + 1;
+                const size_t right = 2 * pos + 2;
+
+                if (left < index && compare(buffer[left], buffer[smallest])) {
+                    smallest = left;
+                }
+
+                if (right < index && compare(buffer[right], buffer[smallest])) {
+                    smallest = right;
+                }
+
+                if (smallest == pos) {
+                    break;
+                }
+
+                std::swap(buffer[pos], buffer[smallest]);
+                pos = smallest;
+            }
+        }
+
+    public:
+        /**
+         * Put an item on the queue; dropped
+         * when the queue is full.
+         *
+         * @param item
+         */
+        void push(const T &item) {
+            // Checked before the write: a push on a full
+            // queue is a defined drop instead of an
+            // out-of-bounds store.
+            if (full()) {
+                return;
+            }
+
+            buffer[index] = item;
+            sift_up(index);
+
+            index += 1;
+        }
+
+        /**
+         * Put an item on the queue, moving instead of
+         * copying it; dropped when the queue is full.
+         *
+         * @param item
+         */
+        void push(T &&item) {
+            if (full()) {
+                return;
+            }
+
+            buffer[index] = std::move(item);
+            sift_up(index);
+
+            index += 1;
+        }
+
+        /**
+         * Construct an item directly on the queue.
+         *
+         * @tparam Args
+         * @param args
+         */
+        template<typename ...Args>
+        void emplace(Args&& ...args) {
+            push(T(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Pop the front item from the queue;
+         * a no-op when the queue is empty.
+         */
+        void pop() {
+            if (empty()) {
+                return;
+            }
+
+            index -= 1;
+
+            if (index != 0) {
+                buffer[0] = std::move(buffer[index]);
+                sift_down(0);
+            }
+        }
+
+        /**
+         * Get the front item from the queue and pop; a
+         * value-initialized item when the queue is empty.
+         */
+        T copy_and_pop() {
+            if (empty()) {
+                return T{};
+            }
+
+            T item = std::move(buffer[0]);
+            pop();
+
+            return item;
+        }
+
+        /**
+         * Get the item that orders first.
+         */
+        T const &front() const {
+            return buffer[0];
+        }
+
+        /**
+         * Get the current size of the queue.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return index;
+        }
+
+        /**
+         * Is the queue empty?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Is the queue full?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Clears the queue.
+         */
+        void clear() {
+            index = 0;
+        }
+
+        /**
+         * Get the maximum size of the queue.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
@@ -2,57 +2,463 @@
 
 #include <cstring>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "instrumentation.hpp"
+#include "storage.hpp"
+#include "trace.hpp"
 
 namespace r2d2 {
-    enum class queue_optimization : bool {
-        READ = false,
-        WRITE = true
+    enum class queue_optimization {
+        READ,
+        WRITE,
+
+        // Keep head/tail indices like a ringbuffer, making
+        // both push and pop O(1) at the cost of a wrap-around
+        // calculation on each access.
+        BOTH
     };
 
+    /**
+     * Head-index base for queue_c: only the BOTH
+     * optimization mode keeps a physical head index, so the
+     * other modes inherit the empty specialization below and
+     * stay a word smaller (empty base optimization, like
+     * instrumentation_c).
+     *
+     * @tparam Circular
+     */
+    template<bool Circular>
+    class queue_head_c {
+    protected:
+        // Physical index of the front element.
+        size_t head = 0;
+    };
+
+    template<>
+    class queue_head_c<false> {};
+
     /**
      * Simple queue implementation.
      *
+     * Elements live in a storage_c, so non-trivial element
+     * types are only constructed when pushed and destroyed
+     * when popped or cleared; trivial types keep the plain
+     * zero-initialized array.
+     *
+     * The Alignment parameter aligns the internal buffer,
+     * e.g. to a 32 or 64 byte cache line or a DMA requirement.
+     * To place an instance in a specific memory region (say
+     * DTCM), combine it with the toolchain's section attribute
+     * on the instance:
+     *
+     *     __attribute__((section(".dtcm")))
+     *     r2d2::queue_c<uint8_t, 256> queue;
+     *
+     * With Instrumented set, the queue tracks occupancy and
+     * traffic statistics (high watermark, push/pop totals,
+     * overflow and underflow counts) readable through
+     * statistics(); when off the updates compile out and the
+     * queue is exactly as large as before.
+     *
+     * The TraceHook policy is invoked on every single-element
+     * push, pop and drop with the instance, operation and
+     * occupancy (see trace.hpp); the default no-op compiles
+     * away entirely. The batch paths do not trace per element
+     * and are covered by the instrumentation counters only.
+     *
      * @tparam T
      * @tparam MaxSize
      * @tparam Optimization
+     * @tparam Alignment
+     * @tparam Instrumented
+     * @tparam TraceHook
      */
-    template<typename T, size_t MaxSize, queue_optimization Optimization = queue_optimization::WRITE>
-    class queue_c {
+    template<
+        typename T,
+        size_t MaxSize,
+        queue_optimization Optimization = queue_optimization::WRITE,
+        size_t Alignment = alignof(T),
+        bool Instrumented = false,
+        typename TraceHook = no_trace_s
+    >
+    class queue_c
+        : public instrumentation_c<Instrumented>,
+          public queue_head_c<Optimization == queue_optimization::BOTH> {
     protected:
-        T buffer[MaxSize] = {};
+        static_assert(
+            Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+            "Alignment has to be a power of 2 and at least alignof(T)"
+        );
+
+        storage_c<T, MaxSize, Alignment> buffer;
         size_t index = 0;
 
+        /**
+         * Get a pointer to the physical location of
+         * the front element.
+         *
+         * @return
+         */
+        T *front_position() {
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                return &buffer[0];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return &buffer[this->head];
+            } else {
+                return empty() ? &buffer[0] : &buffer[index - 1];
+            }
+        }
+
+        /**
+         * Get a pointer to the physical location of
+         * the front element.
+         *
+         * @return
+         */
+        const T *front_position() const {
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                return &buffer[0];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return &buffer[this->head];
+            } else {
+                return empty() ? &buffer[0] : &buffer[index - 1];
+            }
+        }
+
+        /**
+         * Get the physical index of the element at the
+         * given logical position (0 is the front).
+         *
+         * @param logical
+         * @return size_t
+         */
+        size_t physical_index(size_t logical) const {
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                return logical;
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return (this->head + logical) % MaxSize;
+            } else {
+                return index - 1 - logical;
+            }
+        }
+
+        /**
+         * Binary search for the logical position of the
+         * first element that is not ordered before the
+         * given item.
+         *
+         * @param item
+         * @param compare
+         * @return size_t
+         */
+        template<typename Compare>
+        size_t sorted_position(const T &item, Compare &compare) const {
+            size_t low = 0;
+            size_t high = index;
+
+            while (low < high) {
+                const size_t middle = low + (high - low) / 2;
+
+                if (compare(buffer[physical_index(middle)], item)) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+
+            return low;
+        }
+
+        /**
+         * Remove the first count elements with a single
+         * compaction, instead of the per-pop shift.
+         *
+         * @param count at most index
+         */
+        void discard_front(size_t count) {
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                const size_t remaining = index - count;
+
+                // One block move of the survivors instead of
+                // count full shifts.
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    memmove(&buffer[0], &buffer[count], remaining * sizeof(T));
+                } else {
+                    for (size_t i = 0; i < remaining; i++) {
+                        buffer.set(i, std::move(buffer[i + count]));
+                    }
+                }
+
+                for (size_t i = remaining; i < index; i++) {
+                    buffer.destroy(i);
+                }
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                for (size_t i = 0; i < count; i++) {
+                    buffer.destroy((this->head + i) % MaxSize);
+                }
+
+                this->head = (this->head + count) % MaxSize;
+            } else {
+                // READ mode keeps its front at the physical
+                // end, so no shift is needed at all.
+                for (size_t i = index - count; i < index; i++) {
+                    buffer.destroy(i);
+                }
+            }
+
+            index -= count;
+
+            if constexpr (Instrumented) {
+                this->count_pops(count);
+            }
+        }
+
+        /**
+         * Shift the first count elements of the buffer one
+         * position up, using a single block move when T
+         * allows it.
+         *
+         * @param count
+         */
+        void shift_up(size_t count) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                memmove(&buffer[1], &buffer[0], count * sizeof(T));
+            } else {
+                for (size_t i = count; i != 0; i--) {
+                    buffer.set(i, std::move(buffer[i - 1]));
+                }
+            }
+        }
+
+        /**
+         * Shift elements 1 up to and including count of the
+         * buffer one position down, using a single block
+         * move when T allows it.
+         *
+         * @param count
+         */
+        void shift_down(size_t count) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                memmove(&buffer[0], &buffer[1], count * sizeof(T));
+            } else {
+                for (size_t i = 1; i <= count; i++) {
+                    buffer.set(i - 1, std::move(buffer[i]));
+                }
+            }
+        }
+
     public:
         /**
-         * Put an item on the queue.
+         * Put an item on the queue; dropped
+         * when the queue is full.
          *
          * @param item
          */
         void push(const T &item) {
+            // Checked before the write: a push on a full
+            // queue is a defined drop instead of an
+            // out-of-bounds store.
+            if (full()) {
+                if constexpr (Instrumented) {
+                    this->count_overflows(1);
+                }
+
+                TraceHook::trace(this, trace_operation::DROP, index);
+
+                return;
+            }
+
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                buffer.set(index, item);
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                buffer.set((this->head + index) % MaxSize, item);
+            } else {
+                shift_up(index);
+                buffer.set(0, item);
+            }
+
+            index += 1;
+
+            if constexpr (Instrumented) {
+                this->count_pushes(1, index);
+            }
+
+            TraceHook::trace(this, trace_operation::PUSH, index);
+        }
+
+        /**
+         * Put an item on the queue, moving instead of
+         * copying it; dropped when the queue is full.
+         *
+         * @param item
+         */
+        void push(T &&item) {
+            // Checked before the write: a push on a full
+            // queue is a defined drop instead of an
+            // out-of-bounds store.
+            if (full()) {
+                if constexpr (Instrumented) {
+                    this->count_overflows(1);
+                }
+
+                TraceHook::trace(this, trace_operation::DROP, index);
+
+                return;
+            }
+
             if constexpr (Optimization == queue_optimization::WRITE) {
-                buffer[index] = item;
+                buffer.set(index, std::move(item));
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                buffer.set((this->head + index) % MaxSize, std::move(item));
             } else {
-                for (size_t i = index; i != 0; i--) {
-                    buffer[i] = buffer[i - 1];
+                shift_up(index);
+                buffer.set(0, std::move(item));
+            }
+
+            index += 1;
+
+            if constexpr (Instrumented) {
+                this->count_pushes(1, index);
+            }
+
+            TraceHook::trace(this, trace_operation::PUSH, index);
+        }
+
+        /**
+         * Construct an item directly on the queue.
+         *
+         * @tparam Args
+         * @param args
+         */
+        template<typename ...Args>
+        void emplace(Args&& ...args) {
+            push(T(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Insert an item at its sorted position, found by
+         * binary search; only the suffix after that position
+         * is shifted.
+         *
+         * When every item is inserted this way the queue
+         * stays sorted and front() is the smallest item
+         * (with the default compare), e.g. the nearest
+         * deadline of a timer queue.
+         *
+         * @param item
+         * @param compare
+         */
+        template<typename Compare = std::less<T>>
+        void insert_sorted(const T &item, Compare compare = Compare()) {
+            // Same defined drop on a full queue as push.
+            if (full()) {
+                if constexpr (Instrumented) {
+                    this->count_overflows(1);
                 }
 
-                buffer[0] = item;
+                TraceHook::trace(this, trace_operation::DROP, index);
+
+                return;
+            }
+
+            const size_t pos = sorted_position(item, compare);
+
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                // Shift the physical suffix [pos, index) up.
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (index > pos) {
+                        memmove(
+                            &buffer[pos + 1], &buffer[pos],
+                            (index - pos) * sizeof(T)
+                        );
+                    }
+                } else {
+                    for (size_t i = index; i > pos; i--) {
+                        buffer.set(i, std::move(buffer[i - 1]));
+                    }
+                }
+
+                buffer.set(pos, item);
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                for (size_t i = index; i > pos; i--) {
+                    buffer.set(
+                        (this->head + i) % MaxSize,
+                        std::move(buffer[(this->head + i - 1) % MaxSize])
+                    );
+                }
+
+                buffer.set((this->head + pos) % MaxSize, item);
+            } else {
+                // READ mode stores its items reversed, so the
+                // elements before the insert position are the
+                // physical suffix [index - pos, index).
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (pos > 0) {
+                        memmove(
+                            &buffer[index - pos + 1], &buffer[index - pos],
+                            pos * sizeof(T)
+                        );
+                    }
+                } else {
+                    for (size_t i = index; i > index - pos; i--) {
+                        buffer.set(i, std::move(buffer[i - 1]));
+                    }
+                }
+
+                buffer.set(index - pos, item);
             }
 
             index += 1;
+
+            if constexpr (Instrumented) {
+                this->count_pushes(1, index);
+            }
+
+            TraceHook::trace(this, trace_operation::PUSH, index);
         }
 
         /**
          * Pop an item from the queue.
          */
         void pop() {
+            if constexpr (Instrumented) {
+                if (empty()) {
+                    this->count_underflow();
+                } else {
+                    this->count_pops(1);
+                }
+            }
+
+            // Popping an empty queue must not touch a slot:
+            // index - 1 would wrap and destroy through a
+            // wild index for non-trivial types.
             if constexpr (Optimization == queue_optimization::WRITE) {
-                for (size_t i = 1; i < index; i++) {
-                    buffer[i - 1] = buffer[i];
+                if (index > 1) {
+                    shift_down(index - 1);
+                }
+
+                if (!empty()) {
+                    buffer.destroy(index - 1);
+                }
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                if (!empty()) {
+                    buffer.destroy(this->head);
+                }
+
+                this->head = (this->head + 1) % MaxSize;
+            } else {
+                if (!empty()) {
+                    buffer.destroy(index - 1);
                 }
             }
 
             index -= 1;
+
+            TraceHook::trace(this, trace_operation::POP, index);
         }
 
         /**
@@ -60,18 +466,67 @@ namespace r2d2 {
          * and pop.
          */
         T copy_and_pop() {
-            T item = front();
+            T item = std::move(front());
             pop();
 
             return item;
         }
 
+        /**
+         * Pop the first count items at once.
+         *
+         * In WRITE mode this costs one block move of the
+         * remaining items instead of one per pop, so a bulk
+         * drain is O(n) instead of O(count * n).
+         *
+         * @param count
+         * @return the number of items popped
+         */
+        size_t pop_n(size_t count) {
+            if (count > index) {
+                count = index;
+            }
+
+            if (count > 0) {
+                discard_front(count);
+            }
+
+            return count;
+        }
+
+        /**
+         * Visit the first count items front to back and pop
+         * them afterwards with a single compaction.
+         *
+         * @param callback invoked with a reference to each item
+         * @param count defaults to the whole queue
+         * @return the number of items consumed
+         */
+        template<typename Callback>
+        size_t consume(Callback &&callback, size_t count = MaxSize) {
+            if (count > index) {
+                count = index;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                callback(buffer[physical_index(i)]);
+            }
+
+            if (count > 0) {
+                discard_front(count);
+            }
+
+            return count;
+        }
+
         /**
          * Get the next in the queue.
          */
         T &front() {
             if constexpr (Optimization == queue_optimization::WRITE) {
                 return buffer[0];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return buffer[this->head];
             } else {
                 return buffer[index - 1];
             }
@@ -83,6 +538,8 @@ namespace r2d2 {
         T const &front() const {
             if constexpr (Optimization == queue_optimization::WRITE) {
                 return buffer[0];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return buffer[this->head];
             } else {
                 return buffer[index - 1];
             }
@@ -94,6 +551,8 @@ namespace r2d2 {
         T &back() {
             if constexpr (Optimization == queue_optimization::WRITE) {
                 return buffer[index - 1];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return buffer[(this->head + index - 1) % MaxSize];
             } else {
                 return buffer[0];
             }
@@ -105,11 +564,172 @@ namespace r2d2 {
         T const &back() const {
             if constexpr (Optimization == queue_optimization::WRITE) {
                 return buffer[index - 1];
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                return buffer[(this->head + index - 1) % MaxSize];
             } else {
                 return buffer[0];
             }
         }
 
+        /**
+         * Forward iterator over the stored items, from
+         * front to back.
+         *
+         * The storage order depends on the optimization
+         * mode, so the iterator walks the buffer in the
+         * direction that matches it.
+         *
+         * @tparam ValueT
+         */
+        template<typename ValueT>
+        class iterator_t {
+        protected:
+            ValueT *position;
+            ValueT *storage;
+            size_t remaining;
+
+            friend class queue_c;
+
+            iterator_t(ValueT *position, ValueT *storage, size_t remaining)
+                : position(position), storage(storage), remaining(remaining) {}
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueT;
+            using difference_type = ptrdiff_t;
+            using pointer = ValueT *;
+            using reference = ValueT &;
+
+            ValueT &operator*() const {
+                return *position;
+            }
+
+            ValueT *operator->() const {
+                return position;
+            }
+
+            iterator_t &operator++() {
+                if constexpr (Optimization == queue_optimization::WRITE) {
+                    position += 1;
+                } else if constexpr (Optimization == queue_optimization::BOTH) {
+                    position += 1;
+
+                    if (position == storage + MaxSize) {
+                        position = storage;
+                    }
+                } else {
+                    // Don't step before the buffer when
+                    // leaving the last element.
+                    if (remaining > 1) {
+                        position -= 1;
+                    }
+                }
+
+                remaining -= 1;
+                return *this;
+            }
+
+            iterator_t operator++(int) {
+                iterator_t copy = *this;
+                ++(*this);
+
+                return copy;
+            }
+
+            bool operator==(const iterator_t &other) const {
+                return remaining == other.remaining;
+            }
+
+            bool operator!=(const iterator_t &other) const {
+                return remaining != other.remaining;
+            }
+        };
+
+        using iterator = iterator_t<T>;
+        using const_iterator = iterator_t<const T>;
+
+        /**
+         * Get an iterator to the front of the queue.
+         *
+         * @return
+         */
+        iterator begin() {
+            return {front_position(), &buffer[0], index};
+        }
+
+        /**
+         * Get an iterator past the back of the queue.
+         *
+         * @return
+         */
+        iterator end() {
+            return {front_position(), &buffer[0], 0};
+        }
+
+        /**
+         * Get an iterator to the front of the queue.
+         *
+         * @return
+         */
+        const_iterator begin() const {
+            return {front_position(), &buffer[0], index};
+        }
+
+        /**
+         * Get an iterator past the back of the queue.
+         *
+         * @return
+         */
+        const_iterator end() const {
+            return {front_position(), &buffer[0], 0};
+        }
+
+        /**
+         * Get an iterator to the first element that is not
+         * ordered before the given item, found by binary
+         * search; end() when there is none.
+         *
+         * Only meaningful when the queue is kept sorted
+         * with insert_sorted.
+         *
+         * @param item
+         * @param compare
+         * @return
+         */
+        template<typename Compare = std::less<T>>
+        iterator lower_bound(const T &item, Compare compare = Compare()) {
+            const size_t pos = sorted_position(item, compare);
+
+            if (pos == index) {
+                return end();
+            }
+
+            return {&buffer[physical_index(pos)], &buffer[0], index - pos};
+        }
+
+        /**
+         * Get an iterator to the first element that is not
+         * ordered before the given item, found by binary
+         * search; end() when there is none.
+         *
+         * Only meaningful when the queue is kept sorted
+         * with insert_sorted.
+         *
+         * @param item
+         * @param compare
+         * @return
+         */
+        template<typename Compare = std::less<T>>
+        const_iterator lower_bound(const T &item, Compare compare = Compare()) const {
+            const size_t pos = sorted_position(item, compare);
+
+            if (pos == index) {
+                return end();
+            }
+
+            return {&buffer[physical_index(pos)], &buffer[0], index - pos};
+        }
+
         /**
          * Get the current size of the queue.
          *
@@ -145,7 +765,122 @@ namespace r2d2 {
          * @return 
          */
         void clear() {
+            buffer.destroy_all();
+
             index = 0;
+
+            if constexpr (Optimization == queue_optimization::BOTH) {
+                this->head = 0;
+            }
+        }
+
+        /**
+         * Serialize the contents into a flat wire format:
+         * a header of two uint32's (item count, element
+         * size) followed by the items front-first. WRITE
+         * and BOTH mode queues need at most two memcpy's;
+         * READ mode stores its items reversed and copies
+         * per element.
+         *
+         * The format matches ringbuffer_c, so a snapshot
+         * can be replayed into either container.
+         *
+         * @param dest
+         * @param cap
+         * @return the number of bytes written; 0 when dest is too small
+         */
+        size_t serialize_into(uint8_t *dest, size_t cap) const {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "serialization needs a trivially copyable T"
+            );
+
+            const size_t needed = 2 * sizeof(uint32_t) + index * sizeof(T);
+
+            if (cap < needed) {
+                return 0;
+            }
+
+            const uint32_t count = index;
+            const uint32_t element_size = sizeof(T);
+
+            memcpy(dest, &count, sizeof(count));
+            memcpy(dest + sizeof(count), &element_size, sizeof(element_size));
+
+            uint8_t *payload = dest + 2 * sizeof(uint32_t);
+
+            if constexpr (Optimization == queue_optimization::WRITE) {
+                memcpy(payload, &buffer[0], index * sizeof(T));
+            } else if constexpr (Optimization == queue_optimization::BOTH) {
+                const size_t first
+                    = (index < MaxSize - this->head) ? index : MaxSize - this->head;
+
+                memcpy(payload, &buffer[this->head], first * sizeof(T));
+                memcpy(
+                    payload + first * sizeof(T), &buffer[0],
+                    (index - first) * sizeof(T)
+                );
+            } else {
+                for (size_t i = 0; i < index; i++) {
+                    memcpy(
+                        payload + i * sizeof(T), &buffer[index - 1 - i],
+                        sizeof(T)
+                    );
+                }
+            }
+
+            return needed;
+        }
+
+        /**
+         * Replace the contents with items serialized by
+         * serialize_into (of either this queue type or a
+         * ringbuffer_c).
+         *
+         * @param source
+         * @param size
+         * @return the number of bytes read; 0 when the data does not fit
+         */
+        size_t deserialize_from(const uint8_t *source, size_t size) {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "serialization needs a trivially copyable T"
+            );
+
+            if (size < 2 * sizeof(uint32_t)) {
+                return 0;
+            }
+
+            uint32_t count = 0;
+            uint32_t element_size = 0;
+
+            memcpy(&count, source, sizeof(count));
+            memcpy(&element_size, source + sizeof(count), sizeof(element_size));
+
+            const size_t needed = 2 * sizeof(uint32_t) + count * sizeof(T);
+
+            if (element_size != sizeof(T) || count > MaxSize || size < needed) {
+                return 0;
+            }
+
+            clear();
+
+            const uint8_t *payload = source + 2 * sizeof(uint32_t);
+
+            if constexpr (Optimization == queue_optimization::READ) {
+                for (size_t i = 0; i < count; i++) {
+                    memcpy(
+                        &buffer[count - 1 - i], payload + i * sizeof(T),
+                        sizeof(T)
+                    );
+                }
+            } else {
+                memcpy(&buffer[0], payload, count * sizeof(T));
+            }
+
+            index = count;
+
+            return needed;
         }
 
         /**
@@ -167,4 +902,156 @@ namespace r2d2 {
             return Optimization;
         }
     };
+
+    /**
+     * Queue over caller-provided storage, with the capacity
+     * as a runtime value instead of a template parameter.
+     *
+     * Like ringbuffer_view_c this exists so firmware that
+     * needs many queue sizes can share one copy of the
+     * push/pop code in flash instead of instantiating the
+     * template per size. It uses circular head/tail indices
+     * (the BOTH optimization mode), so push and pop are
+     * both O(1).
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class queue_view_c {
+    protected:
+        T *buffer;
+        size_t capacity;
+
+        size_t index = 0;
+        size_t head = 0;
+
+        /**
+         * Wrap an index to the buffer boundary; the index
+         * may exceed the capacity by at most capacity - 1.
+         *
+         * @param position
+         * @return size_t
+         */
+        size_t wrap(size_t position) const {
+            return (position >= capacity) ? position - capacity : position;
+        }
+
+    public:
+        /**
+         * Construct a view over the given storage.
+         *
+         * @param buffer
+         * @param capacity
+         */
+        queue_view_c(T *buffer, size_t capacity)
+            : buffer(buffer), capacity(capacity) {}
+
+        /**
+         * Put an item on the queue; dropped
+         * when the queue is full.
+         *
+         * @param item
+         */
+        void push(const T &item) {
+            // Same defined drop on a full queue as the
+            // BOTH-mode queue_c this view mirrors.
+            if (full()) {
+                return;
+            }
+
+            buffer[wrap(head + index)] = item;
+            index += 1;
+        }
+
+        /**
+         * Pop an item from the queue.
+         */
+        void pop() {
+            head = wrap(head + 1);
+            index -= 1;
+        }
+
+        /**
+         * Get the next item from the queue
+         * and pop.
+         */
+        T copy_and_pop() {
+            T item = front();
+            pop();
+
+            return item;
+        }
+
+        /**
+         * Get the next in the queue.
+         */
+        T &front() {
+            return buffer[head];
+        }
+
+        /**
+         * Get the next in the queue.
+         */
+        T const &front() const {
+            return buffer[head];
+        }
+
+        /**
+         * Get the last item in the queue.
+         */
+        T &back() {
+            return buffer[wrap(head + index - 1)];
+        }
+
+        /**
+         * Get the last item in the queue.
+         */
+        T const &back() const {
+            return buffer[wrap(head + index - 1)];
+        }
+
+        /**
+         * Get the current size of the queue.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return index;
+        }
+
+        /**
+         * Is the queue empty?
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Is the queue full?
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == max_size();
+        }
+
+        /**
+         * Clears the queue.
+         */
+        void clear() {
+            index = 0;
+            head = 0;
+        }
+
+        /**
+         * Get the maximum size of the queue.
+         *
+         * @return size_t
+         */
+        size_t max_size() const {
+            return capacity;
+        }
+    };
 }
@@ -1,26 +1,116 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "instrumentation.hpp"
+#include "storage.hpp"
+#include "trace.hpp"
 
 namespace r2d2 {
+    /**
+     * A contiguous run of elements inside a buffer,
+     * e.g. for handing to a DMA controller.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    struct buffer_segment_s {
+        T *data;
+        size_t size;
+    };
+
+    enum class ringbuffer_policy {
+        // Overwrite the oldest item when the buffer is full.
+        OVERWRITE,
+
+        // Reject the pushed item when the buffer is full.
+        REJECT,
+
+        // Treat pushing onto a full buffer as a programming
+        // error (checked with assert).
+        ASSERT
+    };
+
     /**
      * Simple ringbuffer implementation.
-     * 
+     *
      * Note: when you use a MaxSize that is not a power of 2,
-     * you are missing out on a compiler optimization that replaces
-     * the (expensive) modulo operation with a logical and.
+     * you are missing out on an optimization that replaces the
+     * (expensive) modulo operation with a logical and; with a
+     * power of 2 MaxSize every index wrap is a single mask.
+     * Use pow2_ringbuffer_c to enforce this at compile time.
+     *
+     * The Policy template parameter selects what happens when
+     * the buffer overflows; the OVERWRITE and REJECT policies
+     * count the lost items, readable through dropped().
+     *
+     * The Alignment parameter aligns the internal buffer,
+     * e.g. to a 32 or 64 byte cache line or a DMA requirement.
+     * To place an instance in a specific memory region (say
+     * DTCM), combine it with the toolchain's section attribute
+     * on the instance:
+     *
+     *     __attribute__((section(".dtcm")))
+     *     r2d2::ringbuffer_c<uint8_t, 1024> buffer;
+     *
+     * Elements live in a storage_c, so non-trivial element
+     * types are only constructed when pushed and destroyed
+     * when popped or reset; trivial types keep the plain
+     * zero-initialized array (and compile-time prefill).
+     *
+     * With Instrumented set, the buffer tracks occupancy and
+     * traffic statistics (high watermark, push/pop totals,
+     * overflow and underflow counts) readable through
+     * statistics(); when off the updates compile out and the
+     * buffer is exactly as large as before.
+     *
+     * @tparam T
+     * The TraceHook policy is invoked on every single-element
+     * push, pop and drop with the instance, operation and
+     * occupancy (see trace.hpp); the default no-op compiles
+     * away entirely. The batch paths do not trace per element
+     * and are covered by the instrumentation counters only.
      *
      * @tparam T
      * @tparam MaxSize
+     * @tparam Policy
+     * @tparam Alignment
+     * @tparam Instrumented
+     * @tparam TraceHook
      */
-    template<typename T, size_t MaxSize>
-    class ringbuffer_c {
+    template<
+        typename T,
+        size_t MaxSize,
+        ringbuffer_policy Policy = ringbuffer_policy::OVERWRITE,
+        size_t Alignment = alignof(T),
+        bool Instrumented = false,
+        typename TraceHook = no_trace_s
+    >
+    class ringbuffer_c : public instrumentation_c<Instrumented> {
     protected:
-        T buffer[MaxSize] = {};
+        static_assert(
+            Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+            "Alignment has to be a power of 2 and at least alignof(T)"
+        );
+
+        // With a power of 2 MaxSize every index wrap is a
+        // single logical and instead of a modulo.
+        static constexpr bool is_power_of_two = (MaxSize & (MaxSize - 1)) == 0;
+
+        storage_c<T, MaxSize, Alignment> buffer;
 
         size_t head = 0;
         size_t tail = 0;
         size_t used = 0;
+        size_t drops = 0;
 
         /**
          * Get the index at which a
@@ -37,7 +127,8 @@ namespace r2d2 {
 
             if (full()) {
                 tail = head;
-                head = (head + 1) % MaxSize;
+                head = wrap(head + 1);
+                drops += 1;
             } else {
                 used += 1;
             }
@@ -45,23 +136,159 @@ namespace r2d2 {
             return prev_tail;
         }
 
+        /**
+         * Wrap an index to the buffer boundary, masking
+         * instead of dividing when MaxSize allows it.
+         *
+         * @param index
+         * @return constexpr size_t
+         */
+        static constexpr size_t wrap(size_t index) {
+            if constexpr (is_power_of_two) {
+                return index & (MaxSize - 1);
+            } else {
+                return index % MaxSize;
+            }
+        }
+
+        /**
+         * Copy a contiguous run of elements into the buffer,
+         * using memcpy when T allows it.
+         *
+         * @param dest
+         * @param source
+         * @param count
+         */
+        void copy_in(size_t dest, const T *source, size_t count) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                memcpy(&buffer[dest], source, count * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    buffer.set(dest + i, source[i]);
+                }
+            }
+        }
+
+        /**
+         * Move a contiguous run of elements out of the
+         * buffer, using memcpy when T allows it.
+         *
+         * @param dest
+         * @param source
+         * @param count
+         */
+        void copy_out(T *dest, size_t source, size_t count) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                memcpy(dest, &buffer[source], count * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    dest[i] = std::move(buffer[source + i]);
+                    buffer.destroy(source + i);
+                }
+            }
+        }
+
     public:
         /**
          * Default constructor.
          */
         constexpr ringbuffer_c() = default;
 
+        /**
+         * Construct a ringbuffer prefilled with the given
+         * items, usable at compile time:
+         *
+         *     constexpr ringbuffer_c<int, 4> buffer = {1, 2, 3};
+         *
+         * @param items
+         */
+        constexpr ringbuffer_c(std::initializer_list<T> items) {
+            for (const T &item : items) {
+                push(item);
+            }
+        }
+
+        /**
+         * Construct a ringbuffer prefilled with count items
+         * produced by calling generator(0 .. count - 1),
+         * usable at compile time to e.g. bake a lookup
+         * table into .rodata:
+         *
+         *     constexpr ringbuffer_c<int, 256> table(
+         *         [](size_t i) { return int(i * i); }
+         *     );
+         *
+         * @tparam Generator
+         * @param generator
+         * @param count
+         */
+        template<
+            typename Generator,
+            typename = std::enable_if_t<
+                std::is_invocable_r_v<T, Generator, size_t>
+            >
+        >
+        constexpr ringbuffer_c(Generator &&generator, size_t count = MaxSize) {
+            for (size_t i = 0; i < count; i++) {
+                push(generator(i));
+            }
+        }
+
         /**
          * Add an item to the ringbuffer.
          *
+         * With the REJECT policy the return value indicates
+         * whether the item was stored; otherwise a reference
+         * to the stored item is returned.
+         *
          * @param val
          * @return
          */
-        constexpr T& push(const T &val) {
-            const auto index = get_next_location();
-            buffer[index] = val;
+        constexpr std::conditional_t<
+            Policy == ringbuffer_policy::REJECT, bool, T&
+        > push(const T &val) {
+            if constexpr (Instrumented) {
+                if (full()) {
+                    this->count_overflows(1);
+                }
+            }
 
-            return buffer[index];
+            if constexpr (Policy == ringbuffer_policy::REJECT) {
+                if (full()) {
+                    drops += 1;
+                    TraceHook::trace(this, trace_operation::DROP, used);
+
+                    return false;
+                }
+
+                buffer.set(get_next_location(), val);
+
+                if constexpr (Instrumented) {
+                    this->count_pushes(1, used);
+                }
+
+                TraceHook::trace(this, trace_operation::PUSH, used);
+
+                return true;
+            } else {
+                if constexpr (Policy == ringbuffer_policy::ASSERT) {
+                    assert(!full());
+                }
+
+                if (full()) {
+                    TraceHook::trace(this, trace_operation::DROP, used);
+                }
+
+                T &item = buffer.set(get_next_location(), val);
+
+                if constexpr (Instrumented) {
+                    this->count_pushes(1, used);
+                }
+
+                TraceHook::trace(this, trace_operation::PUSH, used);
+
+                return item;
+            }
         }
 
         /**
@@ -72,11 +299,207 @@ namespace r2d2 {
          * @return constexpr T& 
          */
         template<typename ...Args>
-        constexpr T& emplace(Args&& ...args) {
-            const auto index = get_next_location();
-            buffer[index] = T(std::forward<Args>(args)...);
-            
-            return buffer[index];
+        constexpr std::conditional_t<
+            Policy == ringbuffer_policy::REJECT, bool, T&
+        > emplace(Args&& ...args) {
+            if constexpr (Instrumented) {
+                if (full()) {
+                    this->count_overflows(1);
+                }
+            }
+
+            if constexpr (Policy == ringbuffer_policy::REJECT) {
+                if (full()) {
+                    drops += 1;
+                    TraceHook::trace(this, trace_operation::DROP, used);
+
+                    return false;
+                }
+
+                buffer.emplace(get_next_location(), std::forward<Args>(args)...);
+
+                if constexpr (Instrumented) {
+                    this->count_pushes(1, used);
+                }
+
+                TraceHook::trace(this, trace_operation::PUSH, used);
+
+                return true;
+            } else {
+                if constexpr (Policy == ringbuffer_policy::ASSERT) {
+                    assert(!full());
+                }
+
+                if (full()) {
+                    TraceHook::trace(this, trace_operation::DROP, used);
+                }
+
+                T &item = buffer.emplace(
+                    get_next_location(), std::forward<Args>(args)...
+                );
+
+                if constexpr (Instrumented) {
+                    this->count_pushes(1, used);
+                }
+
+                TraceHook::trace(this, trace_operation::PUSH, used);
+
+                return item;
+            }
+        }
+
+        /**
+         * Add a batch of items to the ringbuffer.
+         *
+         * The transfer is split into at most two contiguous
+         * copies and head, tail and used are updated once,
+         * instead of paying the per-element bookkeeping of
+         * push in a loop. As with push, the oldest items are
+         * overwritten when the buffer overflows.
+         *
+         * @param source
+         * @param count
+         */
+        void push_n(const T *source, size_t count) {
+            if constexpr (Policy == ringbuffer_policy::REJECT) {
+                // Only take what fits; the rest is dropped.
+                const size_t free = MaxSize - used;
+
+                if (count > free) {
+                    drops += count - free;
+                    count = free;
+                }
+            } else if constexpr (Policy == ringbuffer_policy::ASSERT) {
+                assert(count <= MaxSize - used);
+            } else if (used + count > MaxSize) {
+                drops += used + count - MaxSize;
+            }
+
+            // Only the last MaxSize items would survive anyway.
+            if (count > MaxSize) {
+                source += count - MaxSize;
+                count = MaxSize;
+            }
+
+            if (tail >= MaxSize) {
+                tail = 0;
+            }
+
+            const size_t first = (count < MaxSize - tail) ? count : MaxSize - tail;
+            copy_in(tail, source, first);
+            copy_in(0, source + first, count - first);
+
+            tail = wrap(tail + count);
+
+            if (used + count > MaxSize) {
+                if constexpr (Instrumented) {
+                    this->count_overflows(used + count - MaxSize);
+                }
+
+                // Overflowed; the head moves past the overwritten items.
+                head = wrap(head + (used + count - MaxSize));
+                used = MaxSize;
+            } else {
+                used += count;
+            }
+
+            if constexpr (Instrumented) {
+                this->count_pushes(count, used);
+            }
+        }
+
+        /**
+         * Copy a batch of items from the front of the
+         * ringbuffer into dest and pop them, using at most
+         * two contiguous copies.
+         *
+         * @param dest
+         * @param count
+         * @return the number of items actually popped
+         */
+        size_t pop_n(T *dest, size_t count) {
+            if (count > used) {
+                count = used;
+            }
+
+            const size_t first = (count < MaxSize - head) ? count : MaxSize - head;
+            copy_out(dest, head, first);
+            copy_out(dest + first, 0, count - first);
+
+            head = wrap(head + count);
+            used -= count;
+
+            if constexpr (Instrumented) {
+                this->count_pops(count);
+            }
+
+            return count;
+        }
+
+        /**
+         * Get the largest readable contiguous run starting
+         * at the front of the ringbuffer, without copying.
+         *
+         * Consume (part of) the run with commit_read; the
+         * segment stays valid until the buffer is written to.
+         *
+         * @return
+         */
+        buffer_segment_s<const T> front_contiguous() const {
+            const size_t count = (used < MaxSize - head) ? used : MaxSize - head;
+
+            return {&buffer[head], count};
+        }
+
+        /**
+         * Pop count items that were read through
+         * front_contiguous; count must not exceed the
+         * size of the returned segment.
+         *
+         * @param count
+         */
+        void commit_read(size_t count) {
+            head = wrap(head + count);
+            used -= count;
+        }
+
+        /**
+         * Claim the largest writable contiguous run at the
+         * back of the ringbuffer, without copying.
+         *
+         * Unlike push this never overwrites stored items;
+         * an empty segment is returned when the buffer is
+         * full. Publish the written items with commit_write.
+         *
+         * @return
+         */
+        buffer_segment_s<T> claim_write() {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "claim_write writes into raw storage and needs a "
+                "trivially copyable T"
+            );
+
+            if (tail >= MaxSize) {
+                tail = 0;
+            }
+
+            const size_t free = MaxSize - used;
+            const size_t count = (free < MaxSize - tail) ? free : MaxSize - tail;
+
+            return {&buffer[tail], count};
+        }
+
+        /**
+         * Publish count items written through claim_write;
+         * count must not exceed the size of the returned
+         * segment.
+         *
+         * @param count
+         */
+        void commit_write(size_t count) {
+            tail = wrap(tail + count);
+            used += count;
         }
 
         /**
@@ -86,26 +509,43 @@ namespace r2d2 {
          * @return
          */
         constexpr T copy_and_pop() {
+            // Check before reading: on an empty buffer the
+            // slot is unconstructed for non-trivial types.
+            if (!used) {
+                if constexpr (Instrumented) {
+                    this->count_underflow();
+                }
+
+                return T{};
+            }
+
+            if constexpr (Instrumented) {
+                this->count_pops(1);
+            }
+
             size_t pos = 0;
 
-            // Get previous position
-            if (tail) {
-                pos = tail - 1;
+            if constexpr (is_power_of_two) {
+                pos = (tail + MaxSize - 1) & (MaxSize - 1);
             } else {
-                // Tail is at 0, shift to end
-                pos = MaxSize - 1;
+                // Get previous position
+                if (tail) {
+                    pos = tail - 1;
+                } else {
+                    // Tail is at 0, shift to end
+                    pos = MaxSize - 1;
+                }
             }
 
-            T item = buffer[pos];
+            T item = std::move(buffer[pos]);
 
-            if (!used) {
-                // At last item
-                return item;
-            }
+            buffer.destroy(pos);
 
             // Remove last item
             used--;
 
+            TraceHook::trace(this, trace_operation::POP, used);
+
             // Move tail back 1 or back to maxsize - 1
             if (!(tail)) {
                 tail = MaxSize - 1;
@@ -122,30 +562,319 @@ namespace r2d2 {
          * @return constexpr T 
          */
         constexpr T copy_and_pop_front() {
+            // Check before reading: on an empty buffer the
+            // slot is unconstructed for non-trivial types.
+            if (empty()) {
+                if constexpr (Instrumented) {
+                    this->count_underflow();
+                }
+
+                return T{};
+            }
+
+            if constexpr (Instrumented) {
+                this->count_pops(1);
+            }
+
             // Get the data on head
-            T item = buffer[head];
+            T item = std::move(buffer[head]);
+            buffer.destroy(head);
 
             // move the head to its new location
-            if (head < (MaxSize - 1)) {
-                head++;
+            if constexpr (is_power_of_two) {
+                head = (head + 1) & (MaxSize - 1);
             } else {
-                head = 0;
+                if (head < (MaxSize - 1)) {
+                    head++;
+                } else {
+                    head = 0;
+                }
             }
 
             used--;
 
+            TraceHook::trace(this, trace_operation::POP, used);
+
             return item;
         }
 
+        /**
+         * Forward iterator over the stored items, from the
+         * oldest (head) to the newest.
+         *
+         * The iterator carries a raw pointer and only wraps
+         * at the physical buffer boundary, so traversal is a
+         * pointer increment plus one branch instead of the
+         * index wrap of operator[].
+         *
+         * @tparam ValueT
+         */
+        template<typename ValueT>
+        class iterator_t {
+        protected:
+            ValueT *position;
+            ValueT *storage;
+            size_t remaining;
+
+            friend class ringbuffer_c;
+
+            constexpr iterator_t(ValueT *position, ValueT *storage, size_t remaining)
+                : position(position), storage(storage), remaining(remaining) {}
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueT;
+            using difference_type = ptrdiff_t;
+            using pointer = ValueT *;
+            using reference = ValueT &;
+
+            constexpr ValueT &operator*() const {
+                return *position;
+            }
+
+            constexpr ValueT *operator->() const {
+                return position;
+            }
+
+            constexpr iterator_t &operator++() {
+                position += 1;
+
+                if (position == storage + MaxSize) {
+                    position = storage;
+                }
+
+                remaining -= 1;
+                return *this;
+            }
+
+            constexpr iterator_t operator++(int) {
+                iterator_t copy = *this;
+                ++(*this);
+
+                return copy;
+            }
+
+            constexpr bool operator==(const iterator_t &other) const {
+                return remaining == other.remaining;
+            }
+
+            constexpr bool operator!=(const iterator_t &other) const {
+                return remaining != other.remaining;
+            }
+        };
+
+        using iterator = iterator_t<T>;
+        using const_iterator = iterator_t<const T>;
+
+        /**
+         * Get an iterator to the oldest stored item.
+         *
+         * @return
+         */
+        constexpr iterator begin() {
+            return {&buffer[head], &buffer[0], used};
+        }
+
+        /**
+         * Get an iterator past the newest stored item.
+         *
+         * @return
+         */
+        constexpr iterator end() {
+            return {&buffer[head], &buffer[0], 0};
+        }
+
+        /**
+         * Get an iterator to the oldest stored item.
+         *
+         * @return
+         */
+        constexpr const_iterator begin() const {
+            return {&buffer[head], &buffer[0], used};
+        }
+
+        /**
+         * Get an iterator past the newest stored item.
+         *
+         * @return
+         */
+        constexpr const_iterator end() const {
+            return {&buffer[head], &buffer[0], 0};
+        }
+
+        /**
+         * Invoke callback(T*, size_t) for the one or two
+         * contiguous runs the stored items occupy, oldest
+         * run first, so scans can run at raw-array speed
+         * (and auto-vectorize) instead of going through the
+         * index wrap of operator[] per element.
+         *
+         * @param callback
+         */
+        template<typename Callback>
+        void for_each_segment(Callback &&callback) {
+            const size_t first = (used < MaxSize - head) ? used : MaxSize - head;
+
+            if (first != 0) {
+                callback(&buffer[head], first);
+            }
+
+            if (used - first != 0) {
+                callback(&buffer[0], used - first);
+            }
+        }
+
+        /**
+         * Invoke callback(const T*, size_t) for the one or
+         * two contiguous runs the stored items occupy,
+         * oldest run first.
+         *
+         * @param callback
+         */
+        template<typename Callback>
+        void for_each_segment(Callback &&callback) const {
+            const size_t first = (used < MaxSize - head) ? used : MaxSize - head;
+
+            if (first != 0) {
+                callback(&buffer[head], first);
+            }
+
+            if (used - first != 0) {
+                callback(&buffer[0], used - first);
+            }
+        }
+
+        /**
+         * Get a pointer to the smallest stored item,
+         * scanning the contiguous runs directly.
+         *
+         * @return nullptr when the buffer is empty
+         */
+        const T *min_element() const {
+            const T *smallest = nullptr;
+
+            for_each_segment([&smallest](const T *data, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (smallest == nullptr || data[i] < *smallest) {
+                        smallest = &data[i];
+                    }
+                }
+            });
+
+            return smallest;
+        }
+
+        /**
+         * Get a pointer to the largest stored item,
+         * scanning the contiguous runs directly.
+         *
+         * @return nullptr when the buffer is empty
+         */
+        const T *max_element() const {
+            const T *largest = nullptr;
+
+            for_each_segment([&largest](const T *data, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (largest == nullptr || *largest < data[i]) {
+                        largest = &data[i];
+                    }
+                }
+            });
+
+            return largest;
+        }
+
+        /**
+         * Serialize the contents into a flat wire format:
+         * a header of two uint32's (item count, element
+         * size) followed by the items oldest-first, copied
+         * with at most two memcpy's.
+         *
+         * @param dest
+         * @param cap
+         * @return the number of bytes written; 0 when dest is too small
+         */
+        size_t serialize_into(uint8_t *dest, size_t cap) const {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "serialization needs a trivially copyable T"
+            );
+
+            const size_t needed = 2 * sizeof(uint32_t) + used * sizeof(T);
+
+            if (cap < needed) {
+                return 0;
+            }
+
+            const uint32_t count = used;
+            const uint32_t element_size = sizeof(T);
+
+            memcpy(dest, &count, sizeof(count));
+            memcpy(dest + sizeof(count), &element_size, sizeof(element_size));
+
+            uint8_t *payload = dest + 2 * sizeof(uint32_t);
+
+            const size_t first = (used < MaxSize - head) ? used : MaxSize - head;
+            memcpy(payload, &buffer[head], first * sizeof(T));
+            memcpy(
+                payload + first * sizeof(T), &buffer[0],
+                (used - first) * sizeof(T)
+            );
+
+            return needed;
+        }
+
+        /**
+         * Replace the contents with items serialized by
+         * serialize_into.
+         *
+         * @param source
+         * @param size
+         * @return the number of bytes read; 0 when the data does not fit
+         */
+        size_t deserialize_from(const uint8_t *source, size_t size) {
+            static_assert(
+                std::is_trivially_copyable_v<T>,
+                "serialization needs a trivially copyable T"
+            );
+
+            if (size < 2 * sizeof(uint32_t)) {
+                return 0;
+            }
+
+            uint32_t count = 0;
+            uint32_t element_size = 0;
+
+            memcpy(&count, source, sizeof(count));
+            memcpy(&element_size, source + sizeof(count), sizeof(element_size));
+
+            const size_t needed = 2 * sizeof(uint32_t) + count * sizeof(T);
+
+            if (element_size != sizeof(T) || count > MaxSize || size < needed) {
+                return 0;
+            }
+
+            reset();
+            memcpy(&buffer[0], source + 2 * sizeof(uint32_t), count * sizeof(T));
+
+            tail = wrap(count);
+            used = count;
+
+            return needed;
+        }
+
         /**
          * Reset (empty) the ringbuffer.
          *
          * @return
          */
         constexpr void reset() {
+            buffer.destroy_all();
+
             head = 0;
             tail = 0;
             used = 0;
+            drops = 0;
         }
 
         /**
@@ -155,7 +884,7 @@ namespace r2d2 {
          * @return
          */
         constexpr T &operator[](const size_t index) {
-            return buffer[(head + index) % MaxSize];
+            return buffer[wrap(head + index)];
         }
 
         /**
@@ -165,7 +894,7 @@ namespace r2d2 {
          * @return
          */
         constexpr T const &operator[](const size_t index) const {
-            return buffer[(head + index) % MaxSize];
+            return buffer[wrap(head + index)];
         }
 
         /**
@@ -186,6 +915,16 @@ namespace r2d2 {
             return used == MaxSize;
         }
 
+        /**
+         * Get the number of items lost to overflow
+         * (overwritten or rejected, depending on the policy).
+         *
+         * @return
+         */
+        constexpr size_t dropped() const {
+            return drops;
+        }
+
         /**
          * Get the current size of the ringbuffer.
          *
@@ -204,4 +943,303 @@ namespace r2d2 {
             return MaxSize;
         }
     };
+
+    /**
+     * Ringbuffer that only accepts a power of 2 MaxSize,
+     * guaranteeing that every index wrap compiles to a single
+     * logical and. Use this for hot paths (e.g. a scheduler
+     * run queue) where a hidden divide is not acceptable.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Policy
+     * @tparam Alignment
+     */
+    template<
+        typename T,
+        size_t MaxSize,
+        ringbuffer_policy Policy = ringbuffer_policy::OVERWRITE,
+        size_t Alignment = alignof(T),
+        bool Instrumented = false,
+        typename TraceHook = no_trace_s
+    >
+    class pow2_ringbuffer_c
+        : public ringbuffer_c<
+              T, MaxSize, Policy, Alignment, Instrumented, TraceHook
+          > {
+        static_assert(
+            (MaxSize & (MaxSize - 1)) == 0,
+            "MaxSize of a pow2_ringbuffer_c has to be a power of 2"
+        );
+
+    public:
+        using ringbuffer_c<
+            T, MaxSize, Policy, Alignment, Instrumented, TraceHook
+        >::ringbuffer_c;
+    };
+
+    /**
+     * Ringbuffer over caller-provided storage, with the
+     * capacity as a runtime value instead of a template
+     * parameter.
+     *
+     * Every distinct MaxSize of ringbuffer_c instantiates a
+     * full copy of its methods; when a firmware links many
+     * sizes, routing them through one view type keeps a
+     * single copy of the hot-path code in flash (and in the
+     * I-cache). The price is that capacity is a runtime
+     * value, so wraps cannot be reduced to a mask at compile
+     * time; the view uses compare-and-subtract wraps, which
+     * avoids the divide.
+     *
+     * Behaves like ringbuffer_c with the OVERWRITE policy.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class ringbuffer_view_c {
+    protected:
+        T *buffer;
+        size_t capacity;
+
+        size_t head = 0;
+        size_t tail = 0;
+        size_t used = 0;
+
+        /**
+         * Wrap an index to the buffer boundary; the index
+         * may exceed the capacity by at most capacity - 1.
+         *
+         * @param index
+         * @return size_t
+         */
+        size_t wrap(size_t index) const {
+            return (index >= capacity) ? index - capacity : index;
+        }
+
+    public:
+        /**
+         * Construct a view over the given storage.
+         *
+         * @param buffer
+         * @param capacity
+         */
+        ringbuffer_view_c(T *buffer, size_t capacity)
+            : buffer(buffer), capacity(capacity) {}
+
+        /**
+         * Add an item to the ringbuffer, overwriting the
+         * oldest item when full.
+         *
+         * @param val
+         * @return
+         */
+        T &push(const T &val) {
+            buffer[tail] = val;
+
+            const size_t index = tail;
+            tail = wrap(tail + 1);
+
+            if (full()) {
+                head = wrap(head + 1);
+            } else {
+                used += 1;
+            }
+
+            return buffer[index];
+        }
+
+        /**
+         * Copy the first item from the buffer and pop.
+         *
+         * @return
+         */
+        T copy_and_pop_front() {
+            T item = buffer[head];
+
+            head = wrap(head + 1);
+            used -= 1;
+
+            return item;
+        }
+
+        /**
+         * Reset (empty) the ringbuffer.
+         */
+        void reset() {
+            head = 0;
+            tail = 0;
+            used = 0;
+        }
+
+        /**
+         * Get the value at the given index.
+         *
+         * @param index
+         * @return
+         */
+        T &operator[](const size_t index) {
+            return buffer[wrap(head + index)];
+        }
+
+        /**
+         * Get the value at the given index.
+         *
+         * @param index
+         * @return
+         */
+        T const &operator[](const size_t index) const {
+            return buffer[wrap(head + index)];
+        }
+
+        /**
+         * Return whether the ringbuffer is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            return used == 0;
+        }
+
+        /**
+         * Return whether the ringbuffer is full.
+         *
+         * @return
+         */
+        bool full() const {
+            return used == capacity;
+        }
+
+        /**
+         * Get the current size of the ringbuffer.
+         *
+         * @return
+         */
+        size_t size() const {
+            return used;
+        }
+
+        /**
+         * Get the maximum size of the ringbuffer.
+         *
+         * @return
+         */
+        size_t max_size() const {
+            return capacity;
+        }
+    };
+
+    /**
+     * Single-producer single-consumer ringbuffer.
+     *
+     * This variant is wait-free for exactly one producer
+     * (e.g. an interrupt handler) and one consumer (e.g. the
+     * main loop), so no critical sections are needed around
+     * push and pop. The head and tail indices increase
+     * monotonically and are masked on access, which is why
+     * MaxSize has to be a power of 2.
+     *
+     * Unlike ringbuffer_c, push does not overwrite the oldest
+     * item when the buffer is full; it rejects the item instead,
+     * as overwriting would require the producer to move the head
+     * the consumer owns.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     */
+    template<typename T, size_t MaxSize>
+    class spsc_ringbuffer_c {
+    protected:
+        static_assert(
+            (MaxSize & (MaxSize - 1)) == 0,
+            "MaxSize of a spsc_ringbuffer_c has to be a power of 2"
+        );
+
+        T buffer[MaxSize] = {};
+
+        // Only written by the consumer.
+        std::atomic<size_t> head = {0};
+
+        // Only written by the producer.
+        std::atomic<size_t> tail = {0};
+
+    public:
+        /**
+         * Default constructor.
+         */
+        spsc_ringbuffer_c() = default;
+
+        /**
+         * Add an item to the ringbuffer.
+         * Only the producer may call this.
+         *
+         * @param val
+         * @return whether the item was stored; false when full
+         */
+        bool push(const T &val) {
+            const size_t current_tail = tail.load(std::memory_order_relaxed);
+
+            if (current_tail - head.load(std::memory_order_acquire) == MaxSize) {
+                return false;
+            }
+
+            buffer[current_tail & (MaxSize - 1)] = val;
+            tail.store(current_tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * Copy the first item from the buffer and pop.
+         * Only the consumer may call this; the buffer
+         * has to be non-empty.
+         *
+         * @return
+         */
+        T copy_and_pop_front() {
+            const size_t current_head = head.load(std::memory_order_relaxed);
+
+            T item = buffer[current_head & (MaxSize - 1)];
+            head.store(current_head + 1, std::memory_order_release);
+
+            return item;
+        }
+
+        /**
+         * Return whether the ringbuffer is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Return whether the ringbuffer is full.
+         *
+         * @return
+         */
+        bool full() const {
+            return size() == MaxSize;
+        }
+
+        /**
+         * Get the current size of the ringbuffer.
+         *
+         * @return
+         */
+        size_t size() const {
+            return tail.load(std::memory_order_acquire)
+                - head.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Get the maximum size of the ringbuffer.
+         *
+         * @return
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace r2d2 {
+    /**
+     * Fixed-size element storage for the containers in this
+     * library.
+     *
+     * For trivially constructible and destructible types this
+     * is a plain (constexpr-capable) zero-initialized array,
+     * exactly what the containers used to hold themselves.
+     * For other types the specialization below keeps
+     * uninitialized raw bytes and placement-constructs
+     * elements on first write, so a large container of a
+     * non-trivial type no longer default-constructs (or
+     * zero-initializes) MaxSize elements up front.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Alignment
+     * @tparam Trivial
+     */
+    template<
+        typename T,
+        size_t MaxSize,
+        size_t Alignment = alignof(T),
+        bool Trivial = std::is_trivially_constructible_v<T>
+            && std::is_trivially_destructible_v<T>
+    >
+    class storage_c {
+    protected:
+        alignas(Alignment) T buffer[MaxSize] = {};
+
+    public:
+        /**
+         * Get the element at the given (physical) index.
+         *
+         * @param index
+         * @return
+         */
+        constexpr T &operator[](const size_t index) {
+            return buffer[index];
+        }
+
+        /**
+         * Get the element at the given (physical) index.
+         *
+         * @param index
+         * @return
+         */
+        constexpr T const &operator[](const size_t index) const {
+            return buffer[index];
+        }
+
+        /**
+         * Store a value at the given index.
+         *
+         * @param index
+         * @param value
+         * @return
+         */
+        template<typename U>
+        constexpr T &set(const size_t index, U &&value) {
+            buffer[index] = std::forward<U>(value);
+
+            return buffer[index];
+        }
+
+        /**
+         * Construct a value at the given index.
+         *
+         * @tparam Args
+         * @param index
+         * @param args
+         * @return
+         */
+        template<typename ...Args>
+        constexpr T &emplace(const size_t index, Args&& ...args) {
+            buffer[index] = T(std::forward<Args>(args)...);
+
+            return buffer[index];
+        }
+
+        /**
+         * Destroy the element at the given index;
+         * a no-op for trivial types.
+         */
+        constexpr void destroy(const size_t) {}
+
+        /**
+         * Destroy all elements; a no-op for
+         * trivial types.
+         */
+        constexpr void destroy_all() {}
+    };
+
+    /**
+     * Storage specialization for non-trivial element types:
+     * uninitialized aligned bytes with placement construction
+     * on first write and explicit destruction, tracked with a
+     * per-slot constructed flag.
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Alignment
+     */
+    template<typename T, size_t MaxSize, size_t Alignment>
+    class storage_c<T, MaxSize, Alignment, false> {
+    protected:
+        alignas(Alignment) unsigned char bytes[MaxSize * sizeof(T)];
+        bool constructed[MaxSize] = {};
+
+        /**
+         * Get a typed pointer to the given slot.
+         *
+         * @param index
+         * @return
+         */
+        T *slot(const size_t index) {
+            return std::launder(reinterpret_cast<T *>(&bytes[index * sizeof(T)]));
+        }
+
+        /**
+         * Get a typed pointer to the given slot.
+         *
+         * @param index
+         * @return
+         */
+        const T *slot(const size_t index) const {
+            return std::launder(
+                reinterpret_cast<const T *>(&bytes[index * sizeof(T)])
+            );
+        }
+
+    public:
+        /**
+         * Default constructor; constructs no elements.
+         */
+        storage_c() = default;
+
+        /**
+         * Copy constructor; copies only the
+         * constructed elements.
+         *
+         * @param other
+         */
+        storage_c(const storage_c &other) {
+            for (size_t i = 0; i < MaxSize; i++) {
+                if (other.constructed[i]) {
+                    new (&bytes[i * sizeof(T)]) T(*other.slot(i));
+                    constructed[i] = true;
+                }
+            }
+        }
+
+        /**
+         * Copy assignment; copies only the
+         * constructed elements.
+         *
+         * @param other
+         */
+        storage_c &operator=(const storage_c &other) {
+            for (size_t i = 0; i < MaxSize; i++) {
+                if (other.constructed[i]) {
+                    set(i, *other.slot(i));
+                } else {
+                    destroy(i);
+                }
+            }
+
+            return *this;
+        }
+
+        ~storage_c() {
+            destroy_all();
+        }
+
+        /**
+         * Get the element at the given (physical) index.
+         *
+         * @param index
+         * @return
+         */
+        T &operator[](const size_t index) {
+            return *slot(index);
+        }
+
+        /**
+         * Get the element at the given (physical) index.
+         *
+         * @param index
+         * @return
+         */
+        T const &operator[](const size_t index) const {
+            return *slot(index);
+        }
+
+        /**
+         * Store a value at the given index, constructing
+         * the slot when it was not in use yet.
+         *
+         * @param index
+         * @param value
+         * @return
+         */
+        template<typename U>
+        T &set(const size_t index, U &&value) {
+            if (!constructed[index]) {
+                new (&bytes[index * sizeof(T)]) T(std::forward<U>(value));
+                constructed[index] = true;
+            } else {
+                *slot(index) = std::forward<U>(value);
+            }
+
+            return *slot(index);
+        }
+
+        /**
+         * Construct a value in place at the given index,
+         * destroying the previous element when the slot
+         * was in use.
+         *
+         * @tparam Args
+         * @param index
+         * @param args
+         * @return
+         */
+        template<typename ...Args>
+        T &emplace(const size_t index, Args&& ...args) {
+            destroy(index);
+
+            new (&bytes[index * sizeof(T)]) T(std::forward<Args>(args)...);
+            constructed[index] = true;
+
+            return *slot(index);
+        }
+
+        /**
+         * Destroy the element at the given index.
+         *
+         * @param index
+         */
+        void destroy(const size_t index) {
+            if (constructed[index]) {
+                slot(index)->~T();
+                constructed[index] = false;
+            }
+        }
+
+        /**
+         * Destroy all constructed elements.
+         */
+        void destroy_all() {
+            for (size_t i = 0; i < MaxSize; i++) {
+                destroy(i);
+            }
+        }
+    };
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ringbuffer.hpp"
+
+namespace r2d2 {
+    /**
+     * Ringbuffer of (timestamp, value) samples with rolling
+     * statistics over a time window.
+     *
+     * A running sum is maintained incrementally on push and
+     * eviction, so count_since() and mean_since() answer
+     * from two stored numbers instead of rescanning the
+     * buffer; the only per-query work is popping the samples
+     * that have expired, and each sample is popped at most
+     * once (O(1) amortized).
+     *
+     * Timestamps are expected to be pushed in non-decreasing
+     * order, e.g. from hwlib::now_us().
+     *
+     * @tparam T
+     * @tparam MaxSize
+     * @tparam Timestamp
+     */
+    template<typename T, size_t MaxSize, typename Timestamp = uint32_t>
+    class time_series_ring_c {
+    public:
+        /**
+         * A single stored sample.
+         */
+        struct sample_s {
+            Timestamp timestamp;
+            T value;
+        };
+
+    protected:
+        ringbuffer_c<sample_s, MaxSize> buffer;
+
+        // Running sum of the stored values.
+        T sum = {};
+
+    public:
+        /**
+         * Add a sample, evicting the oldest one when full.
+         *
+         * @param timestamp
+         * @param value
+         */
+        void push(const Timestamp timestamp, const T &value) {
+            if (buffer.full()) {
+                sum -= buffer.copy_and_pop_front().value;
+            }
+
+            buffer.push(sample_s{timestamp, value});
+            sum += value;
+        }
+
+        /**
+         * Evict all samples older than the given timestamp.
+         *
+         * @param timestamp
+         */
+        void evict_older_than(const Timestamp timestamp) {
+            while (!buffer.empty() && buffer[0].timestamp < timestamp) {
+                sum -= buffer.copy_and_pop_front().value;
+            }
+        }
+
+        /**
+         * Count the samples taken at or after the given
+         * timestamp; older samples are evicted.
+         *
+         * @param timestamp
+         * @return size_t
+         */
+        size_t count_since(const Timestamp timestamp) {
+            evict_older_than(timestamp);
+
+            return buffer.size();
+        }
+
+        /**
+         * Get the mean of the samples taken at or after the
+         * given timestamp; older samples are evicted.
+         *
+         * @param timestamp
+         * @return the mean, or a default-constructed T when
+         *         no samples remain
+         */
+        T mean_since(const Timestamp timestamp) {
+            evict_older_than(timestamp);
+
+            if (buffer.empty()) {
+                return T{};
+            }
+
+            return sum / static_cast<T>(buffer.size());
+        }
+
+        /**
+         * Get the running sum of the stored values.
+         *
+         * @return
+         */
+        const T &total() const {
+            return sum;
+        }
+
+        /**
+         * Get the sample at the given index, oldest first.
+         *
+         * @param index
+         * @return
+         */
+        const sample_s &operator[](const size_t index) const {
+            return buffer[index];
+        }
+
+        /**
+         * Reset (empty) the ring.
+         */
+        void reset() {
+            buffer.reset();
+            sum = {};
+        }
+
+        /**
+         * Get the current size of the ring.
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return buffer.size();
+        }
+
+        /**
+         * Return whether the ring is empty.
+         *
+         * @return
+         */
+        bool empty() const {
+            return buffer.empty();
+        }
+
+        /**
+         * Return whether the ring is full.
+         *
+         * @return
+         */
+        bool full() const {
+            return buffer.full();
+        }
+
+        /**
+         * Get the maximum size of the ring.
+         *
+         * @return constexpr size_t
+         */
+        constexpr size_t max_size() const {
+            return MaxSize;
+        }
+    };
+}
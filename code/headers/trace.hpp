@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace r2d2 {
+    /**
+     * Container operations reported to a trace hook.
+     */
+    enum class trace_operation : uint8_t {
+        PUSH,
+        POP,
+
+        // A push that hit a full container: the overwritten
+        // or rejected item, depending on the policy.
+        DROP
+    };
+
+    /**
+     * Default trace hook: a no-op the optimizer removes, so
+     * an untraced container pays nothing.
+     *
+     * A real hook provides the same static trace() and is
+     * passed as the TraceHook parameter of queue_c or
+     * ringbuffer_c. It receives the container instance, the
+     * operation and the occupancy after the operation for
+     * every single-element push, pop and drop; the batch
+     * transfer and drain paths (push_n/pop_n, the segment
+     * commits and queue_c's pop_n/consume) are counted by
+     * the instrumentation statistics but not traced, e.g.
+     * to log DWT cycle-counter samples into a dedicated
+     * spsc_ringbuffer_c as a flight recorder:
+     *
+     *     struct flight_recorder_s {
+     *         static void trace(const void *instance,
+     *                           trace_operation operation,
+     *                           size_t occupancy) {
+     *             trace_ring.push({cycle_count(), instance,
+     *                              operation, occupancy});
+     *         }
+     *     };
+     */
+    struct no_trace_s {
+        /**
+         * Ignore a reported operation.
+         */
+        static constexpr void trace(const void *, trace_operation, size_t) {}
+    };
+}
@@ -1,10 +1,23 @@
 #include "ostream"
+#include <cstdio>
+#include <numeric>
+#include <thread>
 
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <blocking_ringbuffer.hpp>
+#include <deque.hpp>
+#include <double_buffer.hpp>
+#include <flat_map.hpp>
+#include <message_ring.hpp>
+#include <mmap_ringbuffer.hpp>
+#include <mpmc_queue.hpp>
+#include <pool.hpp>
+#include <priority_queue.hpp>
 #include <queue.hpp>
 #include <ringbuffer.hpp>
+#include <time_series_ring.hpp>
 
 using namespace r2d2;
 
@@ -149,81 +162,1641 @@ TEST_CASE("Ringbuffer emplace works", "[ringbuffer]") {
 }
 
 
+TEST_CASE("Ringbuffer push_n and pop_n transfer batches", "[ringbuffer]") {
+    ringbuffer_c<int, 8> buffer;
+
+    const int source[4] = {5, 15, 25, 35};
+    buffer.push_n(source, 4);
+
+    REQUIRE(buffer.size() == 4);
+
+    int dest[4] = {};
+    REQUIRE(buffer.pop_n(dest, 4) == 4);
+
+    REQUIRE(dest[0] == 5);
+    REQUIRE(dest[1] == 15);
+    REQUIRE(dest[2] == 25);
+    REQUIRE(dest[3] == 35);
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("Ringbuffer push_n wraps and overwrites the oldest items", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+
+    const int source[3] = {4, 5, 6};
+    buffer.push_n(source, 3);
+
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer[0] == 3);
+    REQUIRE(buffer[1] == 4);
+    REQUIRE(buffer[2] == 5);
+    REQUIRE(buffer[3] == 6);
+}
+
+TEST_CASE("Ringbuffer pop_n is limited to the stored items", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+
+    int dest[4] = {};
+    REQUIRE(buffer.pop_n(dest, 4) == 2);
+
+    REQUIRE(dest[0] == 5);
+    REQUIRE(dest[1] == 92);
+}
+
+
+TEST_CASE("Ringbuffer front_contiguous and commit_read work", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.push(18);
+
+    auto segment = buffer.front_contiguous();
+
+    REQUIRE(segment.size == 3);
+    REQUIRE(segment.data[0] == 5);
+    REQUIRE(segment.data[1] == 92);
+    REQUIRE(segment.data[2] == 18);
+
+    buffer.commit_read(2);
+
+    REQUIRE(buffer.size() == 1);
+    REQUIRE(buffer[0] == 18);
+}
+
+TEST_CASE("Ringbuffer front_contiguous stops at the wrap", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    buffer.commit_read(3);
+
+    buffer.push(4);
+    buffer.push(5);
+
+    // Head is at index 3, so only one item is contiguous.
+    auto segment = buffer.front_contiguous();
+
+    REQUIRE(segment.size == 1);
+    REQUIRE(segment.data[0] == 4);
+
+    buffer.commit_read(1);
+
+    REQUIRE(buffer.front_contiguous().size == 1);
+    REQUIRE(buffer.front_contiguous().data[0] == 5);
+}
+
+TEST_CASE("Ringbuffer claim_write and commit_write work", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    auto segment = buffer.claim_write();
+
+    REQUIRE(segment.size == 4);
+
+    segment.data[0] = 5;
+    segment.data[1] = 92;
+    buffer.commit_write(2);
+
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer.copy_and_pop_front() == 5);
+    REQUIRE(buffer.copy_and_pop_front() == 92);
+}
+
+TEST_CASE("Ringbuffer claim_write never claims stored items", "[ringbuffer]") {
+    ringbuffer_c<int, 2> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+
+    REQUIRE(buffer.claim_write().size == 0);
+}
+
+TEST_CASE("Non-power-of-2 ringbuffer wraps correctly", "[ringbuffer]") {
+    ringbuffer_c<int, 3> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.push(18);
+    buffer.push(28);
+
+    REQUIRE(buffer[0] == 92);
+    REQUIRE(buffer[1] == 18);
+    REQUIRE(buffer[2] == 28);
+}
+
+TEST_CASE("Ringbuffer can be prefilled at compile time", "[ringbuffer]") {
+    constexpr ringbuffer_c<int, 4> buffer = {5, 92, 18};
+
+    static_assert(buffer.size() == 3, "compile time prefill failed");
+
+    REQUIRE(buffer[0] == 5);
+    REQUIRE(buffer[1] == 92);
+    REQUIRE(buffer[2] == 18);
+}
+
+TEST_CASE("Ringbuffer can be generated at compile time", "[ringbuffer]") {
+    constexpr ringbuffer_c<int, 8> buffer(
+        [](size_t i) { return static_cast<int>(i * i); }
+    );
+
+    static_assert(buffer.size() == 8, "compile time generation failed");
+
+    REQUIRE(buffer[0] == 0);
+    REQUIRE(buffer[3] == 9);
+    REQUIRE(buffer[7] == 49);
+}
+
+TEST_CASE("Overwrite-policy ringbuffer counts dropped items", "[ringbuffer]") {
+    ringbuffer_c<int, 2> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+
+    REQUIRE(buffer.dropped() == 0);
+
+    buffer.push(18);
+
+    REQUIRE(buffer.dropped() == 1);
+    REQUIRE(buffer[0] == 92);
+    REQUIRE(buffer[1] == 18);
+}
+
+TEST_CASE("Reject-policy ringbuffer refuses a push when full", "[ringbuffer]") {
+    ringbuffer_c<int, 2, ringbuffer_policy::REJECT> buffer;
+
+    REQUIRE(buffer.push(5));
+    REQUIRE(buffer.push(92));
+    REQUIRE_FALSE(buffer.push(18));
+
+    REQUIRE(buffer.dropped() == 1);
+    REQUIRE(buffer[0] == 5);
+    REQUIRE(buffer[1] == 92);
+}
+
+TEST_CASE("Reject-policy ringbuffer push_n only takes what fits", "[ringbuffer]") {
+    ringbuffer_c<int, 4, ringbuffer_policy::REJECT> buffer;
+
+    buffer.push(1);
+
+    const int source[4] = {2, 3, 4, 5};
+    buffer.push_n(source, 4);
+
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer.dropped() == 1);
+    REQUIRE(buffer[0] == 1);
+    REQUIRE(buffer[3] == 4);
+}
+
+TEST_CASE("Aligned containers align their storage", "[ringbuffer][queue]") {
+    ringbuffer_c<uint8_t, 16, ringbuffer_policy::OVERWRITE, 64> buffer;
+    queue_c<uint8_t, 16, queue_optimization::WRITE, 64> queue;
+
+    buffer.push(5);
+    queue.push(5);
+
+    REQUIRE(reinterpret_cast<uintptr_t>(&buffer[0]) % 64 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(&queue.front()) % 64 == 0);
+}
+
+TEST_CASE("Pow2 ringbuffer behaves like a ringbuffer", "[ringbuffer]") {
+    pow2_ringbuffer_c<int, 4> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer.copy_and_pop_front() == 5);
+    REQUIRE(buffer.copy_and_pop() == 92);
+}
+
+
+TEST_CASE("Ringbuffer min_element and max_element work across the wrap", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(30);
+    buffer.push(10);
+    buffer.push(20);
+    buffer.push(40);
+    buffer.push(25);
+
+    REQUIRE(*buffer.min_element() == 10);
+    REQUIRE(*buffer.max_element() == 40);
+}
+
+TEST_CASE("Empty ringbuffer has no min or max element", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    REQUIRE(buffer.min_element() == nullptr);
+    REQUIRE(buffer.max_element() == nullptr);
+}
+
+TEST_CASE("Ringbuffer for_each_segment hands out the contiguous runs", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    buffer.push(4);
+    buffer.push(5);
+
+    size_t segments = 0;
+    size_t total = 0;
+
+    buffer.for_each_segment([&](const int *, size_t count) {
+        segments += 1;
+        total += count;
+    });
+
+    REQUIRE(segments == 2);
+    REQUIRE(total == buffer.size());
+}
+
+TEST_CASE("Ringbuffer iteration visits items oldest to newest", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+    buffer.push(4);
+    buffer.push(5);
+
+    int expected = 2;
+
+    for (const auto &item : buffer) {
+        REQUIRE(item == expected);
+        expected += 1;
+    }
+
+    REQUIRE(expected == 6);
+}
+
+TEST_CASE("Ringbuffer iterators work with standard algorithms", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.push(18);
+
+    REQUIRE(std::accumulate(buffer.begin(), buffer.end(), 0) == 115);
+}
+
+TEST_CASE("Empty ringbuffer begin equals end", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    REQUIRE(buffer.begin() == buffer.end());
+}
+
+
+TEST_CASE("Instrumented ringbuffer tracks statistics", "[ringbuffer]") {
+    ringbuffer_c<int, 2, ringbuffer_policy::OVERWRITE, alignof(int), true> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.push(18);
+    buffer.copy_and_pop_front();
+
+    const auto &stats = buffer.statistics();
+
+    REQUIRE(stats.pushes == 3);
+    REQUIRE(stats.pops == 1);
+    REQUIRE(stats.high_watermark == 2);
+    REQUIRE(stats.overflows == 1);
+    REQUIRE(stats.underflows == 0);
+}
+
+TEST_CASE("Instrumented queue tracks statistics", "[queue]") {
+    queue_c<int, 4, queue_optimization::WRITE, alignof(int), true> q;
+
+    q.push(5);
+    q.push(92);
+    q.push(18);
+    q.pop();
+    q.pop();
+
+    const auto &stats = q.statistics();
+
+    REQUIRE(stats.pushes == 3);
+    REQUIRE(stats.pops == 2);
+    REQUIRE(stats.high_watermark == 3);
+    REQUIRE(stats.overflows == 0);
+    REQUIRE(stats.underflows == 0);
+}
+
+namespace {
+    struct trace_event_s {
+        const void *instance;
+        trace_operation operation;
+        size_t occupancy;
+    };
+
+    // Recording hook for the trace tests below.
+    struct recording_trace_s {
+        static ringbuffer_c<trace_event_s, 16> &events() {
+            static ringbuffer_c<trace_event_s, 16> ring;
+            return ring;
+        }
+
+        static void trace(const void *instance, trace_operation operation,
+                          size_t occupancy) {
+            events().push({instance, operation, occupancy});
+        }
+    };
+}
+
+TEST_CASE("Trace hook sees pushes, pops and drops", "[ringbuffer][queue]") {
+    recording_trace_s::events().reset();
+
+    ringbuffer_c<
+        int, 2, ringbuffer_policy::OVERWRITE, alignof(int),
+        false, recording_trace_s
+    > buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+
+    // Overwrites the oldest item: a drop, then the push.
+    buffer.push(18);
+    buffer.copy_and_pop_front();
+
+    auto &events = recording_trace_s::events();
+
+    REQUIRE(events.size() == 5);
+    REQUIRE(events[0].operation == trace_operation::PUSH);
+    REQUIRE(events[0].instance == &buffer);
+    REQUIRE(events[0].occupancy == 1);
+    REQUIRE(events[2].operation == trace_operation::DROP);
+    REQUIRE(events[3].operation == trace_operation::PUSH);
+    REQUIRE(events[4].operation == trace_operation::POP);
+    REQUIRE(events[4].occupancy == 1);
+}
+
+TEST_CASE("Trace hook works on a queue", "[queue]") {
+    recording_trace_s::events().reset();
+
+    queue_c<
+        int, 4, queue_optimization::WRITE, alignof(int),
+        false, recording_trace_s
+    > queue;
+
+    queue.push(5);
+    queue.pop();
+
+    auto &events = recording_trace_s::events();
+
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].operation == trace_operation::PUSH);
+    REQUIRE(events[1].operation == trace_operation::POP);
+    REQUIRE(events[1].occupancy == 0);
+}
+
+TEST_CASE("Uninstrumented containers stay as small as before", "[ringbuffer][queue]") {
+    REQUIRE(
+        sizeof(ringbuffer_c<int, 4>)
+        < sizeof(ringbuffer_c<int, 4, ringbuffer_policy::OVERWRITE, alignof(int), true>)
+    );
+}
+
+TEST_CASE("Only circular queues pay for the head index", "[queue]") {
+    // WRITE and READ mode queues have no head member; only
+    // the BOTH mode carries the extra word.
+    REQUIRE(
+        sizeof(queue_c<int, 4>)
+        < sizeof(queue_c<int, 4, queue_optimization::BOTH>)
+    );
+    REQUIRE(
+        sizeof(queue_c<int, 4, queue_optimization::READ>)
+        == sizeof(queue_c<int, 4>)
+    );
+}
+
+
+TEST_CASE("Ringbuffer serialization round-trips across the wrap", "[ringbuffer]") {
+    ringbuffer_c<int, 4> source;
+
+    source.push(1);
+    source.push(2);
+    source.push(3);
+    source.push(4);
+    source.push(5);
+
+    uint8_t packet[64] = {};
+    const size_t written = source.serialize_into(packet, sizeof(packet));
+
+    REQUIRE(written == 2 * sizeof(uint32_t) + 4 * sizeof(int));
+
+    ringbuffer_c<int, 8> dest;
+
+    REQUIRE(dest.deserialize_from(packet, written) == written);
+    REQUIRE(dest.size() == 4);
+    REQUIRE(dest[0] == 2);
+    REQUIRE(dest[3] == 5);
+}
+
+TEST_CASE("Queue serialization matches the ringbuffer format", "[queue][ringbuffer]") {
+    queue_c<int, 4, queue_optimization::READ> q;
+
+    q.push(5);
+    q.push(92);
+    q.push(18);
+
+    uint8_t packet[64] = {};
+    const size_t written = q.serialize_into(packet, sizeof(packet));
+
+    REQUIRE(written != 0);
+
+    ringbuffer_c<int, 4> buffer;
+
+    REQUIRE(buffer.deserialize_from(packet, written) == written);
+    REQUIRE(buffer[0] == 5);
+    REQUIRE(buffer[1] == 92);
+    REQUIRE(buffer[2] == 18);
+
+    queue_c<int, 4> copy;
+
+    REQUIRE(copy.deserialize_from(packet, written) == written);
+    REQUIRE(copy.copy_and_pop() == 5);
+    REQUIRE(copy.copy_and_pop() == 92);
+    REQUIRE(copy.copy_and_pop() == 18);
+}
+
+TEST_CASE("Serialization rejects a too-small destination or source", "[ringbuffer]") {
+    ringbuffer_c<int, 4> buffer;
+
+    buffer.push(5);
+
+    uint8_t packet[4] = {};
+
+    REQUIRE(buffer.serialize_into(packet, sizeof(packet)) == 0);
+    REQUIRE(buffer.deserialize_from(packet, sizeof(packet)) == 0);
+}
+
+TEST_CASE("Ringbuffer view works on caller-provided storage", "[ringbuffer]") {
+    int storage[5] = {};
+    ringbuffer_view_c<int> buffer(storage, 5);
+
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.max_size() == 5);
+
+    for (int i = 0; i < 5; i++) {
+        buffer.push(i);
+    }
+
+    REQUIRE(buffer.full());
+    REQUIRE(buffer.copy_and_pop_front() == 0);
+    REQUIRE(buffer.size() == 4);
+}
+
+TEST_CASE("Ringbuffer view overwrites the oldest item when full", "[ringbuffer]") {
+    int storage[3] = {};
+    ringbuffer_view_c<int> buffer(storage, 3);
+
+    for (int i = 0; i < 5; i++) {
+        buffer.push(i);
+    }
+
+    REQUIRE(buffer.size() == 3);
+    REQUIRE(buffer[0] == 2);
+    REQUIRE(buffer[1] == 3);
+    REQUIRE(buffer[2] == 4);
+}
+
+TEST_CASE("One ringbuffer view type serves multiple capacities", "[ringbuffer]") {
+    int small[2] = {};
+    int large[7] = {};
+
+    ringbuffer_view_c<int> a(small, 2);
+    ringbuffer_view_c<int> b(large, 7);
+
+    a.push(1);
+    b.push(2);
+
+    REQUIRE(a.copy_and_pop_front() == 1);
+    REQUIRE(b.copy_and_pop_front() == 2);
+
+    a.reset();
+    REQUIRE(a.empty());
+}
+
+
+/** STORAGE **/
+
+namespace {
+    struct counted_s {
+        static int alive;
+        int value;
+
+        counted_s(int value = 0) : value(value) {
+            alive += 1;
+        }
+
+        counted_s(const counted_s &other) : value(other.value) {
+            alive += 1;
+        }
+
+        counted_s(counted_s &&other) : value(other.value) {
+            alive += 1;
+        }
+
+        counted_s &operator=(const counted_s &) = default;
+        counted_s &operator=(counted_s &&) = default;
+
+        ~counted_s() {
+            alive -= 1;
+        }
+    };
+
+    int counted_s::alive = 0;
+}
+
+TEST_CASE("Containers of non-trivial types construct elements lazily", "[storage]") {
+    counted_s::alive = 0;
+
+    {
+        queue_c<counted_s, 16> q;
+        ringbuffer_c<counted_s, 16> buffer;
+
+        // Nothing is constructed up front.
+        REQUIRE(counted_s::alive == 0);
+
+        q.push(counted_s(5));
+        buffer.push(counted_s(92));
+
+        REQUIRE(counted_s::alive == 2);
+        REQUIRE(q.front().value == 5);
+        REQUIRE(buffer[0].value == 92);
+    }
+
+    // Destroyed with the containers.
+    REQUIRE(counted_s::alive == 0);
+}
+
+TEST_CASE("Pop and clear destroy non-trivial elements", "[storage]") {
+    counted_s::alive = 0;
+
+    queue_c<counted_s, 8> q;
+
+    q.push(counted_s(1));
+    q.push(counted_s(2));
+    q.pop();
+
+    REQUIRE(counted_s::alive == 1);
+
+    q.clear();
+
+    REQUIRE(counted_s::alive == 0);
+
+    ringbuffer_c<counted_s, 8> buffer;
+
+    buffer.push(counted_s(1));
+    buffer.push(counted_s(2));
+    buffer.copy_and_pop_front();
+
+    REQUIRE(counted_s::alive == 1);
+
+    buffer.reset();
+
+    REQUIRE(counted_s::alive == 0);
+}
+
+TEST_CASE("Popping an empty ringbuffer of non-trivial types is safe", "[storage][ringbuffer]") {
+    counted_s::alive = 0;
+
+    {
+        ringbuffer_c<counted_s, 4> buffer;
+
+        // Popping empty returns a default-constructed
+        // element without reading an unconstructed slot.
+        REQUIRE(buffer.copy_and_pop().value == 0);
+        REQUIRE(buffer.copy_and_pop_front().value == 0);
+        REQUIRE(buffer.empty());
+
+        buffer.push(counted_s(5));
+
+        REQUIRE(buffer.copy_and_pop_front().value == 5);
+        REQUIRE(buffer.copy_and_pop_front().value == 0);
+        REQUIRE(buffer.empty());
+    }
+
+    REQUIRE(counted_s::alive == 0);
+}
+
+TEST_CASE("Popping an empty queue of non-trivial types is safe", "[storage][queue]") {
+    counted_s::alive = 0;
+
+    {
+        queue_c<counted_s, 4> write_queue;
+        queue_c<counted_s, 4, queue_optimization::READ> read_queue;
+        queue_c<counted_s, 4, queue_optimization::BOTH> circular_queue;
+
+        for (int i = 0; i < 4; i++) {
+            write_queue.push(counted_s(i));
+            read_queue.push(counted_s(i));
+            circular_queue.push(counted_s(i));
+        }
+
+        for (int i = 0; i < 4; i++) {
+            write_queue.pop();
+            read_queue.pop();
+            circular_queue.pop();
+        }
+
+        REQUIRE(counted_s::alive == 0);
+
+        // One pop past empty must not destroy through a
+        // wild slot index.
+        write_queue.pop();
+        read_queue.pop();
+        circular_queue.pop();
+
+        REQUIRE(counted_s::alive == 0);
+    }
+
+    REQUIRE(counted_s::alive == 0);
+}
+
+TEST_CASE("Ringbuffer emplace constructs non-trivial elements in place", "[storage]") {
+    counted_s::alive = 0;
+
+    ringbuffer_c<counted_s, 4> buffer;
+
+    buffer.emplace(5);
+
+    REQUIRE(counted_s::alive == 1);
+    REQUIRE(buffer[0].value == 5);
+}
+
+
+/** SPSC RINGBUFFER **/
+
+TEST_CASE("Spsc ringbuffer stores data", "[spsc_ringbuffer]") {
+    spsc_ringbuffer_c<int, 16> buffer;
+
+    REQUIRE(buffer.push(5));
+    REQUIRE(buffer.copy_and_pop_front() == 5);
+}
+
+TEST_CASE("Spsc ringbuffer shows the correct size", "[spsc_ringbuffer]") {
+    spsc_ringbuffer_c<int, 16> buffer;
+
+    REQUIRE(buffer.empty());
+
+    buffer.push(5);
+    buffer.push(92);
+
+    REQUIRE(buffer.max_size() == 16);
+    REQUIRE(buffer.size() == 2);
+}
+
+TEST_CASE("Spsc ringbuffer rejects a push when full", "[spsc_ringbuffer]") {
+    spsc_ringbuffer_c<int, 2> buffer;
+
+    REQUIRE(buffer.push(5));
+    REQUIRE(buffer.push(92));
+    REQUIRE(buffer.full());
+    REQUIRE_FALSE(buffer.push(18));
+
+    REQUIRE(buffer.copy_and_pop_front() == 5);
+    REQUIRE(buffer.copy_and_pop_front() == 92);
+}
+
+TEST_CASE("Spsc ringbuffer wraps around the buffer", "[spsc_ringbuffer]") {
+    spsc_ringbuffer_c<int, 2> buffer;
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.copy_and_pop_front();
+    buffer.push(18);
+
+    REQUIRE(buffer.copy_and_pop_front() == 92);
+    REQUIRE(buffer.copy_and_pop_front() == 18);
+    REQUIRE(buffer.empty());
+}
+
+
+/** BLOCKING RINGBUFFER **/
+
+TEST_CASE("Blocking ringbuffer stores data", "[blocking_ringbuffer]") {
+    blocking_ringbuffer_c<int, 4> buffer;
+
+    buffer.push_wait(5);
+    buffer.push_wait(92);
+
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer.pop_wait() == 5);
+    REQUIRE(buffer.pop_wait() == 92);
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("Blocking ringbuffer try variants do not block", "[blocking_ringbuffer]") {
+    blocking_ringbuffer_c<int, 2> buffer;
+
+    int item = 0;
+    REQUIRE_FALSE(buffer.try_pop(item));
+
+    REQUIRE(buffer.try_push(5));
+    REQUIRE(buffer.try_push(92));
+    REQUIRE_FALSE(buffer.try_push(18));
+    REQUIRE(buffer.full());
+
+    REQUIRE(buffer.try_pop(item));
+    REQUIRE(item == 5);
+}
+
+TEST_CASE("Blocking ringbuffer hands items between threads", "[blocking_ringbuffer]") {
+    blocking_ringbuffer_c<int, 2> buffer;
+
+    std::thread producer([&buffer] {
+        for (int i = 0; i < 32; i++) {
+            buffer.push_wait(i);
+        }
+    });
+
+    int sum = 0;
+    for (int i = 0; i < 32; i++) {
+        sum += buffer.pop_wait();
+    }
+
+    producer.join();
+
+    REQUIRE(sum == 31 * 32 / 2);
+    REQUIRE(buffer.empty());
+}
+
+
 /** QUEUE **/
 
-TEST_CASE("Queue stores data", "[queue]") {
-    struct x {
-        int a;
+TEST_CASE("Queue stores data", "[queue]") {
+    struct x {
+        int a;
+
+        x() : a(0) {}
+        x(int a) : a(a) {}
+
+        virtual void foo() {};
+    };
+
+    queue_c<x, 16> q;
+
+    q.push(x(3));
+    q.push(x(5));
+
+    REQUIRE(q.copy_and_pop().a == 3);
+    REQUIRE(q.copy_and_pop().a == 5);
+}
+
+TEST_CASE("Queue front and back work", "[queue]") {
+    queue_c<int, 16> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.front() == 12);
+    REQUIRE(q.back() == 24);
+}
+
+TEST_CASE("Queue popping an empty queue works", "[queue]") {
+    queue_c<int, 2> q;
+
+    q.pop();
+
+    REQUIRE(true);
+}
+
+TEST_CASE("Queue empty, full, max_size and size work", "[queue]") {
+    queue_c<int, 2> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.size() == 2);
+    REQUIRE(q.max_size() == 2);
+    REQUIRE(q.full());
+
+    q.pop();
+    q.pop();
+
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Read-optimized queue front and back work", "[queue]") {
+    queue_c<int, 16, queue_optimization::READ> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.front() == 12);
+    REQUIRE(q.back() == 24);
+}
+
+TEST_CASE("Read-optimized queue popping an empty queue works", "[queue]") {
+    queue_c<int, 2, queue_optimization::READ> q;
+
+    q.pop();
+
+    REQUIRE(true);
+}
+
+TEST_CASE("Read-optimized queue empty, full, max_size and size work", "[queue]") {
+    queue_c<int, 2, queue_optimization::READ> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.size() == 2);
+    REQUIRE(q.max_size() == 2);
+    REQUIRE(q.full());
+
+    q.pop();
+    q.pop();
+
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Circular queue front and back work", "[queue]") {
+    queue_c<int, 16, queue_optimization::BOTH> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.front() == 12);
+    REQUIRE(q.back() == 24);
+}
+
+TEST_CASE("Circular queue wraps around the buffer", "[queue]") {
+    queue_c<int, 2, queue_optimization::BOTH> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.copy_and_pop() == 12);
+
+    q.push(36);
+
+    REQUIRE(q.copy_and_pop() == 24);
+    REQUIRE(q.copy_and_pop() == 36);
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Circular queue empty, full, max_size and size work", "[queue]") {
+    queue_c<int, 2, queue_optimization::BOTH> q;
+
+    q.push(12);
+    q.push(24);
+
+    REQUIRE(q.size() == 2);
+    REQUIRE(q.max_size() == 2);
+    REQUIRE(q.full());
+
+    q.pop();
+    q.pop();
+
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Queue push moves when given an rvalue", "[queue]") {
+    struct x {
+        int a;
+        bool moved;
+
+        x() : a(0), moved(false) {}
+        x(int a) : a(a), moved(false) {}
+        x(const x &other) : a(other.a), moved(false) {}
+        x(x &&other) : a(other.a), moved(true) {}
+
+        x &operator=(const x &other) {
+            a = other.a;
+            moved = false;
+            return *this;
+        }
+
+        x &operator=(x &&other) {
+            a = other.a;
+            moved = true;
+            return *this;
+        }
+    };
+
+    queue_c<x, 4> q;
+
+    q.push(x(3));
+
+    REQUIRE(q.front().a == 3);
+    REQUIRE(q.front().moved);
+}
+
+TEST_CASE("Queue emplace constructs the item", "[queue]") {
+    struct x {
+        int a, b;
+        x() = default;
+        x(int a, int b) : a(a), b(b) {}
+    };
+
+    queue_c<x, 4> q;
+
+    q.emplace(2, 5);
+
+    REQUIRE(q.front().a == 2);
+    REQUIRE(q.front().b == 5);
+}
+
+
+TEST_CASE("Queue iteration visits items front to back", "[queue]") {
+    queue_c<int, 4> a;
+    queue_c<int, 4, queue_optimization::READ> b;
+    queue_c<int, 4, queue_optimization::BOTH> c;
+
+    for (int item : {1, 2, 3}) {
+        a.push(item);
+        b.push(item);
+        c.push(item);
+    }
+
+    REQUIRE(std::accumulate(a.begin(), a.end(), 0) == 6);
+    REQUIRE(std::accumulate(b.begin(), b.end(), 0) == 6);
+    REQUIRE(std::accumulate(c.begin(), c.end(), 0) == 6);
+
+    int expected = 1;
+
+    for (const auto &item : b) {
+        REQUIRE(item == expected);
+        expected += 1;
+    }
+}
+
+TEST_CASE("optimized_for given back the correct result", "[queue]") {
+    queue_c<int, 2, queue_optimization::WRITE> a;
+    queue_c<int, 2, queue_optimization::READ> b;
+
+    REQUIRE(a.optimized_for() == queue_optimization::WRITE);
+    REQUIRE(b.optimized_for() == queue_optimization::READ);
+}
+
+TEST_CASE("Queue push on a full queue is a counted drop", "[queue]") {
+    queue_c<int, 2, queue_optimization::WRITE, alignof(int), true> queue;
+
+    queue.push(5);
+    queue.push(92);
+    queue.push(18);
+
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.front() == 5);
+    REQUIRE(queue.back() == 92);
+
+    queue.insert_sorted(3);
+
+    const auto &stats = queue.statistics();
+
+    REQUIRE(stats.pushes == 2);
+    REQUIRE(stats.overflows == 2);
+}
+
+TEST_CASE("Queue pop_n drains a batch in one compaction", "[queue]") {
+    queue_c<int, 8> queue;
+
+    for (int i = 0; i < 6; i++) {
+        queue.push(i);
+    }
+
+    REQUIRE(queue.pop_n(4) == 4);
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.front() == 4);
+    REQUIRE(queue.back() == 5);
+
+    // Popping more than is stored pops what is there.
+    REQUIRE(queue.pop_n(4) == 2);
+    REQUIRE(queue.empty());
+    REQUIRE(queue.pop_n(1) == 0);
+}
+
+TEST_CASE("Queue consume visits the batch front to back", "[queue]") {
+    queue_c<int, 8> queue;
+
+    for (int i = 1; i <= 5; i++) {
+        queue.push(i * 10);
+    }
+
+    int sum = 0;
+    int last = 0;
+
+    REQUIRE(queue.consume([&](int value) {
+        sum += value;
+        last = value;
+    }, 3) == 3);
+
+    REQUIRE(sum == 10 + 20 + 30);
+    REQUIRE(last == 30);
+    REQUIRE(queue.front() == 40);
+
+    // Without a count the rest of the queue is consumed.
+    REQUIRE(queue.consume([](int) {}) == 2);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Queue pop_n works in every optimization mode", "[queue]") {
+    queue_c<int, 8, queue_optimization::READ> read_queue;
+    queue_c<int, 8, queue_optimization::BOTH> circular_queue;
+
+    // Move the circular queue's head near the wrap first.
+    for (int i = 0; i < 6; i++) {
+        circular_queue.push(i);
+    }
+    REQUIRE(circular_queue.pop_n(6) == 6);
+
+    for (int i = 0; i < 5; i++) {
+        read_queue.push(i);
+        circular_queue.push(i);
+    }
+
+    REQUIRE(read_queue.pop_n(3) == 3);
+    REQUIRE(circular_queue.pop_n(3) == 3);
+
+    REQUIRE(read_queue.copy_and_pop() == 3);
+    REQUIRE(read_queue.copy_and_pop() == 4);
+    REQUIRE(circular_queue.copy_and_pop() == 3);
+    REQUIRE(circular_queue.copy_and_pop() == 4);
+}
+
+TEST_CASE("Sorted insert keeps the queue ordered", "[queue]") {
+    queue_c<int, 8> queue;
+
+    queue.insert_sorted(24);
+    queue.insert_sorted(3);
+    queue.insert_sorted(12);
+    queue.insert_sorted(18);
+
+    REQUIRE(queue.front() == 3);
+    REQUIRE(queue.back() == 24);
+
+    REQUIRE(queue.copy_and_pop() == 3);
+    REQUIRE(queue.copy_and_pop() == 12);
+    REQUIRE(queue.copy_and_pop() == 18);
+    REQUIRE(queue.copy_and_pop() == 24);
+}
+
+TEST_CASE("Sorted insert works in every optimization mode", "[queue]") {
+    queue_c<int, 8, queue_optimization::READ> read_queue;
+    queue_c<int, 8, queue_optimization::BOTH> circular_queue;
+
+    // Move the circular queue's head away from zero first.
+    circular_queue.push(5);
+    circular_queue.pop();
+
+    for (int value : {24, 3, 18, 12}) {
+        read_queue.insert_sorted(value);
+        circular_queue.insert_sorted(value);
+    }
+
+    for (int expected : {3, 12, 18, 24}) {
+        REQUIRE(read_queue.copy_and_pop() == expected);
+        REQUIRE(circular_queue.copy_and_pop() == expected);
+    }
+}
+
+TEST_CASE("Queue lower_bound finds the first element not before an item", "[queue]") {
+    queue_c<int, 8> queue;
+
+    for (int value : {3, 12, 18, 24}) {
+        queue.insert_sorted(value);
+    }
+
+    REQUIRE(*queue.lower_bound(12) == 12);
+    REQUIRE(*queue.lower_bound(13) == 18);
+    REQUIRE(queue.lower_bound(25) == queue.end());
+}
+
+TEST_CASE("Sorted insert supports a custom comparator", "[queue]") {
+    queue_c<int, 4> queue;
+
+    queue.insert_sorted(3, std::greater<int>());
+    queue.insert_sorted(24, std::greater<int>());
+    queue.insert_sorted(12, std::greater<int>());
+
+    REQUIRE(queue.copy_and_pop() == 24);
+    REQUIRE(queue.copy_and_pop() == 12);
+    REQUIRE(queue.copy_and_pop() == 3);
+}
+
+TEST_CASE("Queue view works on caller-provided storage", "[queue]") {
+    int storage[4] = {};
+    queue_view_c<int> queue(storage, 4);
+
+    REQUIRE(queue.empty());
+    REQUIRE(queue.max_size() == 4);
+
+    queue.push(5);
+    queue.push(92);
+
+    REQUIRE(queue.front() == 5);
+    REQUIRE(queue.back() == 92);
+    REQUIRE(queue.copy_and_pop() == 5);
+    REQUIRE(queue.size() == 1);
+}
+
+TEST_CASE("Queue view push on a full queue is a drop", "[queue]") {
+    int storage[2] = {};
+    queue_view_c<int> queue(storage, 2);
+
+    queue.push(5);
+    queue.push(92);
+    queue.push(18);
+
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.full());
+    REQUIRE(queue.front() == 5);
+    REQUIRE(queue.back() == 92);
+}
+
+TEST_CASE("Queue view wraps around the buffer", "[queue]") {
+    int storage[3] = {};
+    queue_view_c<int> queue(storage, 3);
 
-        x() : a(0) {}
-        x(int a) : a(a) {}
+    for (int i = 0; i < 3; i++) {
+        queue.push(i);
+    }
 
-        virtual void foo() {};
+    REQUIRE(queue.full());
+    queue.pop();
+    queue.push(12);
+
+    REQUIRE(queue.front() == 1);
+    REQUIRE(queue.back() == 12);
+
+    queue.clear();
+    REQUIRE(queue.empty());
+}
+
+
+/** DOUBLE BUFFER **/
+
+TEST_CASE("Double buffer swap exposes the written data", "[double_buffer]") {
+    double_buffer_c<int, 4> buffer;
+
+    buffer.write().push(5);
+    buffer.write().push(92);
+
+    REQUIRE(buffer.read().empty());
+
+    buffer.swap();
+
+    REQUIRE(buffer.read().size() == 2);
+    REQUIRE(buffer.read()[0] == 5);
+    REQUIRE(buffer.read()[1] == 92);
+}
+
+TEST_CASE("Double buffer writes after a swap do not tear the snapshot", "[double_buffer]") {
+    double_buffer_c<int, 4> buffer;
+
+    buffer.write().push(5);
+    buffer.swap();
+
+    buffer.write().push(92);
+
+    REQUIRE(buffer.read().size() == 1);
+    REQUIRE(buffer.read()[0] == 5);
+}
+
+TEST_CASE("Double buffer swap hands the writer a cleared side", "[double_buffer]") {
+    double_buffer_c<int, 4> buffer;
+
+    buffer.write().push(5);
+    buffer.swap();
+    buffer.write().push(92);
+    buffer.swap();
+
+    REQUIRE(buffer.write().empty());
+    REQUIRE(buffer.read().size() == 1);
+    REQUIRE(buffer.read()[0] == 92);
+}
+
+
+/** DEQUE **/
+
+TEST_CASE("Deque pushes and pops at both ends", "[deque]") {
+    deque_c<int, 4> deque;
+
+    deque.push_back(92);
+    deque.push_front(5);
+    deque.push_back(18);
+
+    REQUIRE(deque.front() == 5);
+    REQUIRE(deque.back() == 18);
+
+    REQUIRE(deque.copy_and_pop_front() == 5);
+    REQUIRE(deque.copy_and_pop_back() == 18);
+    REQUIRE(deque.copy_and_pop_front() == 92);
+    REQUIRE(deque.empty());
+}
+
+TEST_CASE("Deque wraps around the buffer", "[deque]") {
+    deque_c<int, 3> deque;
+
+    deque.push_back(1);
+    deque.push_back(2);
+    deque.push_back(3);
+
+    REQUIRE(deque.full());
+
+    deque.pop_front();
+    deque.push_back(4);
+
+    REQUIRE(deque[0] == 2);
+    REQUIRE(deque[1] == 3);
+    REQUIRE(deque[2] == 4);
+
+    deque.push_front(deque.copy_and_pop_back());
+
+    REQUIRE(deque.front() == 4);
+    REQUIRE(deque.back() == 3);
+}
+
+TEST_CASE("Deque push on a full deque is a drop", "[deque]") {
+    deque_c<int, 2> deque;
+
+    deque.push_back(5);
+    deque.push_back(92);
+    deque.push_back(18);
+    deque.push_front(3);
+
+    REQUIRE(deque.size() == 2);
+    REQUIRE(deque.full());
+    REQUIRE(deque.front() == 5);
+    REQUIRE(deque.back() == 92);
+}
+
+TEST_CASE("Deque empty, full, max_size, size and clear work", "[deque]") {
+    deque_c<int, 2> deque;
+
+    deque.push_front(5);
+    deque.push_front(92);
+
+    REQUIRE(deque.size() == 2);
+    REQUIRE(deque.max_size() == 2);
+    REQUIRE(deque.full());
+
+    deque.clear();
+
+    REQUIRE(deque.empty());
+}
+
+
+/** FLAT MAP **/
+
+TEST_CASE("Flat map stores and finds values by key", "[flat_map]") {
+    flat_map_c<int, int, 8> map;
+
+    REQUIRE(map.insert(5, 50));
+    REQUIRE(map.insert(2, 20));
+    REQUIRE(map.insert(9, 90));
+
+    REQUIRE(map.contains(2));
+    REQUIRE(*map.find(5) == 50);
+    REQUIRE(*map.find(9) == 90);
+    REQUIRE(map.find(7) == nullptr);
+}
+
+TEST_CASE("Flat map insert updates an existing key", "[flat_map]") {
+    flat_map_c<int, int, 4> map;
+
+    map.insert(5, 50);
+    map.insert(5, 55);
+
+    REQUIRE(map.size() == 1);
+    REQUIRE(*map.find(5) == 55);
+}
+
+TEST_CASE("Flat map rejects an insert when full", "[flat_map]") {
+    flat_map_c<int, int, 2> map;
+
+    REQUIRE(map.insert(1, 10));
+    REQUIRE(map.insert(2, 20));
+    REQUIRE(map.full());
+    REQUIRE_FALSE(map.insert(3, 30));
+
+    // Updating an existing key still works when full.
+    REQUIRE(map.insert(2, 25));
+    REQUIRE(*map.find(2) == 25);
+}
+
+TEST_CASE("Flat map erase removes a key", "[flat_map]") {
+    flat_map_c<int, int, 4> map;
+
+    map.insert(1, 10);
+    map.insert(2, 20);
+    map.insert(3, 30);
+
+    REQUIRE(map.erase(2));
+    REQUIRE_FALSE(map.erase(2));
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.find(1) == 10);
+    REQUIRE(*map.find(3) == 30);
+
+    map.clear();
+
+    REQUIRE(map.empty());
+}
+
+
+/** MMAP RINGBUFFER **/
+
+TEST_CASE("Mmap ringbuffer stores records", "[mmap_ringbuffer]") {
+    const char *path = "/tmp/r2d2_mmap_test_store.bin";
+    std::remove(path);
+
+    mmap_ringbuffer_c<int, 4> buffer;
+
+    REQUIRE(buffer.open(path));
+    REQUIRE(buffer.is_open());
+    REQUIRE(buffer.empty());
+
+    buffer.push(5);
+    buffer.push(92);
+
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer.copy_and_pop_front() == 5);
+    REQUIRE(buffer.copy_and_pop_front() == 92);
+
+    std::remove(path);
+}
+
+TEST_CASE("Mmap ringbuffer contents survive a reopen", "[mmap_ringbuffer]") {
+    const char *path = "/tmp/r2d2_mmap_test_reopen.bin";
+    std::remove(path);
+
+    {
+        mmap_ringbuffer_c<int, 4> writer;
+
+        REQUIRE(writer.open(path));
+
+        writer.push(5);
+        writer.push(92);
+        writer.push(18);
+    }
+
+    mmap_ringbuffer_c<int, 4> reader;
+
+    REQUIRE(reader.open(path));
+    REQUIRE(reader.size() == 3);
+    REQUIRE(reader[0] == 5);
+    REQUIRE(reader[1] == 92);
+    REQUIRE(reader[2] == 18);
+
+    std::remove(path);
+}
+
+TEST_CASE("Mmap ringbuffer overwrites the oldest record when full", "[mmap_ringbuffer]") {
+    const char *path = "/tmp/r2d2_mmap_test_wrap.bin";
+    std::remove(path);
+
+    mmap_ringbuffer_c<int, 2> buffer;
+
+    REQUIRE(buffer.open(path));
+
+    buffer.push(5);
+    buffer.push(92);
+    buffer.push(18);
+
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer[0] == 92);
+    REQUIRE(buffer[1] == 18);
+
+    std::remove(path);
+}
+
+TEST_CASE("Mmap ringbuffer empty pop does not corrupt the file", "[mmap_ringbuffer]") {
+    const char *path = "/tmp/r2d2_mmap_test_empty_pop.bin";
+    std::remove(path);
+
+    {
+        mmap_ringbuffer_c<int, 4> writer;
+
+        REQUIRE(writer.open(path));
+
+        // An empty pop must not underflow the persistent
+        // used count, or the file would never reopen.
+        REQUIRE(writer.copy_and_pop_front() == 0);
+        REQUIRE(writer.empty());
+
+        writer.push(5);
+    }
+
+    mmap_ringbuffer_c<int, 4> reader;
+
+    REQUIRE(reader.open(path));
+    REQUIRE(reader.size() == 1);
+    REQUIRE(reader.copy_and_pop_front() == 5);
+
+    std::remove(path);
+}
+
+TEST_CASE("Mmap ringbuffer refuses a mismatching file", "[mmap_ringbuffer]") {
+    const char *path = "/tmp/r2d2_mmap_test_mismatch.bin";
+    std::remove(path);
+
+    {
+        mmap_ringbuffer_c<int, 4> writer;
+        REQUIRE(writer.open(path));
+        REQUIRE(writer.sync());
+    }
+
+    // A different capacity does not match the stored header.
+    mmap_ringbuffer_c<int, 8> reader;
+
+    REQUIRE_FALSE(reader.open(path));
+    REQUIRE_FALSE(reader.is_open());
+
+    std::remove(path);
+}
+
+
+/** MPMC QUEUE **/
+
+TEST_CASE("Mpmc queue stores data in FIFO order", "[mpmc_queue]") {
+    mpmc_queue_c<int, 4> q;
+
+    REQUIRE(q.push(5));
+    REQUIRE(q.push(92));
+
+    int item = 0;
+
+    REQUIRE(q.copy_and_pop(item));
+    REQUIRE(item == 5);
+    REQUIRE(q.copy_and_pop(item));
+    REQUIRE(item == 92);
+    REQUIRE_FALSE(q.copy_and_pop(item));
+}
+
+TEST_CASE("Mpmc queue rejects a push when full", "[mpmc_queue]") {
+    mpmc_queue_c<int, 2> q;
+
+    REQUIRE(q.push(5));
+    REQUIRE(q.push(92));
+    REQUIRE(q.full());
+    REQUIRE_FALSE(q.push(18));
+
+    int item = 0;
+    q.copy_and_pop(item);
+
+    REQUIRE(q.push(18));
+    REQUIRE(q.size() == 2);
+}
+
+TEST_CASE("Mpmc queue slots are reusable after wrapping", "[mpmc_queue]") {
+    mpmc_queue_c<int, 2> q;
+    int item = 0;
+
+    for (int i = 0; i < 10; i++) {
+        REQUIRE(q.push(i));
+        REQUIRE(q.copy_and_pop(item));
+        REQUIRE(item == i);
+    }
+
+    REQUIRE(q.empty());
+}
+
+
+/** POOL **/
+
+TEST_CASE("Pool hands out distinct constructed items", "[pool]") {
+    pool_c<int, 4> pool;
+
+    int *a = pool.acquire(5);
+    int *b = pool.acquire(92);
+
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    REQUIRE(a != b);
+    REQUIRE(*a == 5);
+    REQUIRE(*b == 92);
+
+    pool.release(a);
+    pool.release(b);
+}
+
+TEST_CASE("Pool acquire forwards constructor arguments", "[pool]") {
+    struct x {
+        int a, b;
+        x(int a, int b) : a(a), b(b) {}
     };
 
-    queue_c<x, 16> q;
+    pool_c<x, 2> pool;
 
-    q.push(x(3));
-    q.push(x(5));
+    x *item = pool.acquire(2, 5);
 
-    REQUIRE(q.copy_and_pop().a == 3);
-    REQUIRE(q.copy_and_pop().a == 5);
+    REQUIRE(item->a == 2);
+    REQUIRE(item->b == 5);
+
+    pool.release(item);
 }
 
-TEST_CASE("Queue front and back work", "[queue]") {
-    queue_c<int, 16> q;
+TEST_CASE("Pool returns nullptr when exhausted and reuses released slots", "[pool]") {
+    pool_c<int, 2> pool;
 
-    q.push(12);
-    q.push(24);
+    int *a = pool.acquire(1);
+    pool.acquire(2);
 
-    REQUIRE(q.front() == 12);
-    REQUIRE(q.back() == 24);
+    REQUIRE(pool.full());
+    REQUIRE(pool.acquire(3) == nullptr);
+
+    pool.release(a);
+
+    int *c = pool.acquire(4);
+
+    REQUIRE(c != nullptr);
+    REQUIRE(*c == 4);
 }
 
-TEST_CASE("Queue popping an empty queue works", "[queue]") {
-    queue_c<int, 2> q;
+TEST_CASE("Pool size, empty, full and max_size work", "[pool]") {
+    pool_c<int, 2> pool;
 
-    q.pop();
+    REQUIRE(pool.empty());
+    REQUIRE(pool.max_size() == 2);
 
-    REQUIRE(true);
+    int *a = pool.acquire(1);
+
+    REQUIRE(pool.size() == 1);
+
+    pool.release(a);
+
+    REQUIRE(pool.empty());
 }
 
-TEST_CASE("Queue empty, full, max_size and size work", "[queue]") {
-    queue_c<int, 2> q;
+
+/** PRIORITY QUEUE **/
+
+TEST_CASE("Priority queue pops items in order", "[priority_queue]") {
+    priority_queue_c<int, 8> q;
+
+    q.push(25);
+    q.push(5);
+    q.push(15);
+
+    REQUIRE(q.copy_and_pop() == 5);
+    REQUIRE(q.copy_and_pop() == 15);
+    REQUIRE(q.copy_and_pop() == 25);
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("Priority queue front is the smallest item", "[priority_queue]") {
+    priority_queue_c<int, 8> q;
 
     q.push(12);
+    q.push(3);
     q.push(24);
 
-    REQUIRE(q.size() == 2);
-    REQUIRE(q.max_size() == 2);
-    REQUIRE(q.full());
+    REQUIRE(q.front() == 3);
+}
 
-    q.pop();
-    q.pop();
+TEST_CASE("Priority queue supports a custom comparator", "[priority_queue]") {
+    priority_queue_c<int, 8, std::greater<int>> q;
 
-    REQUIRE(q.empty());
+    q.push(12);
+    q.push(3);
+    q.push(24);
+
+    REQUIRE(q.copy_and_pop() == 24);
+    REQUIRE(q.copy_and_pop() == 12);
+    REQUIRE(q.copy_and_pop() == 3);
 }
 
-TEST_CASE("Read-optimized queue front and back work", "[queue]") {
-    queue_c<int, 16, queue_optimization::READ> q;
+TEST_CASE("Priority queue push on a full queue is a drop", "[priority_queue]") {
+    priority_queue_c<int, 2> q;
 
     q.push(12);
     q.push(24);
+    q.push(3);
 
-    REQUIRE(q.front() == 12);
-    REQUIRE(q.back() == 24);
+    REQUIRE(q.size() == 2);
+    REQUIRE(q.full());
+    REQUIRE(q.copy_and_pop() == 12);
+    REQUIRE(q.copy_and_pop() == 24);
 }
 
-TEST_CASE("Read-optimized queue popping an empty queue works", "[queue]") {
-    queue_c<int, 2, queue_optimization::READ> q;
+TEST_CASE("Priority queue popping an empty queue works", "[priority_queue]") {
+    priority_queue_c<int, 2> q;
 
     q.pop();
 
-    REQUIRE(true);
+    REQUIRE(q.empty());
+    REQUIRE(q.copy_and_pop() == 0);
+    REQUIRE(q.empty());
+
+    q.push(5);
+
+    REQUIRE(q.copy_and_pop() == 5);
+    REQUIRE(q.copy_and_pop() == 0);
 }
 
-TEST_CASE("Read-optimized queue empty, full, max_size and size work", "[queue]") {
-    queue_c<int, 2, queue_optimization::READ> q;
+TEST_CASE("Priority queue empty, full, max_size, size and clear work", "[priority_queue]") {
+    priority_queue_c<int, 2> q;
 
     q.push(12);
     q.push(24);
@@ -232,18 +1805,140 @@ TEST_CASE("Read-optimized queue empty, full, max_size and size work", "[queue]")
     REQUIRE(q.max_size() == 2);
     REQUIRE(q.full());
 
-    q.pop();
-    q.pop();
+    q.clear();
 
     REQUIRE(q.empty());
 }
 
-TEST_CASE("optimized_for given back the correct result", "[queue]") {
-    queue_c<int, 2, queue_optimization::WRITE> a;
-    queue_c<int, 2, queue_optimization::READ> b;
 
-    REQUIRE(a.optimized_for() == queue_optimization::WRITE);
-    REQUIRE(b.optimized_for() == queue_optimization::READ);
+/** MESSAGE RING **/
+
+TEST_CASE("Message ring stores variable-length messages", "[message_ring]") {
+    message_ring_c<32> ring;
+
+    const uint8_t small[] = {5, 92};
+    const uint8_t large[] = {1, 2, 3, 4, 5, 6, 7};
+
+    REQUIRE(ring.push(small, sizeof(small)));
+    REQUIRE(ring.push(large, sizeof(large)));
+    REQUIRE(ring.size() == 2);
+
+    auto front = ring.front();
+    REQUIRE(front.size == 2);
+    REQUIRE(front.data[0] == 5);
+    REQUIRE(front.data[1] == 92);
+
+    ring.pop();
+
+    front = ring.front();
+    REQUIRE(front.size == 7);
+    REQUIRE(front.data[6] == 7);
+}
+
+TEST_CASE("Message ring memory scales with message size", "[message_ring]") {
+    message_ring_c<16> ring;
+
+    const uint8_t data[] = {1, 2, 3};
+
+    // A 3-byte message costs 4 bytes, not a worst-case slot.
+    REQUIRE(ring.push(data, 3));
+    REQUIRE(ring.used_bytes() == 4);
+}
+
+TEST_CASE("Message ring keeps messages contiguous across the wrap", "[message_ring]") {
+    message_ring_c<16> ring;
+
+    const uint8_t first[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    REQUIRE(ring.push(first, sizeof(first)));
+    ring.pop();
+
+    // Tail is at 10; this message does not fit before the
+    // end, so the remaining bytes become padding.
+    const uint8_t second[] = {11, 12, 13, 14, 15, 16, 17, 18};
+    REQUIRE(ring.push(second, sizeof(second)));
+
+    auto front = ring.front();
+    REQUIRE(front.size == 8);
+
+    for (size_t i = 0; i < front.size; i++) {
+        REQUIRE(front.data[i] == second[i]);
+    }
+
+    ring.pop();
+    REQUIRE(ring.empty());
+    REQUIRE(ring.used_bytes() == 0);
+}
+
+TEST_CASE("Message ring rejects messages that do not fit", "[message_ring]") {
+    message_ring_c<8> ring;
+
+    const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+
+    REQUIRE(ring.push(data, sizeof(data)));
+
+    // 6 + 1 prefix bytes used; another 6-byte message
+    // does not fit.
+    REQUIRE_FALSE(ring.push(data, sizeof(data)));
+    REQUIRE_FALSE(ring.push(data, 0));
+
+    uint8_t dest[8] = {};
+    REQUIRE(ring.copy_and_pop(dest) == 6);
+    REQUIRE(dest[5] == 6);
+
+    REQUIRE(ring.push(data, sizeof(data)));
+}
+
+
+/** TIME SERIES RING **/
+
+TEST_CASE("Time series ring counts samples in a window", "[time_series_ring]") {
+    time_series_ring_c<int, 8> ring;
+
+    ring.push(100, 5);
+    ring.push(150, 92);
+    ring.push(200, 18);
+    ring.push(250, 11);
+
+    REQUIRE(ring.count_since(0) == 4);
+    REQUIRE(ring.count_since(200) == 2);
+}
+
+TEST_CASE("Time series ring keeps an incremental mean", "[time_series_ring]") {
+    time_series_ring_c<int, 8> ring;
+
+    ring.push(100, 2);
+    ring.push(150, 4);
+    ring.push(200, 6);
+
+    REQUIRE(ring.total() == 12);
+    REQUIRE(ring.mean_since(0) == 4);
+
+    // Evicts the sample at t=100; mean of 4 and 6.
+    REQUIRE(ring.mean_since(150) == 5);
+    REQUIRE(ring.total() == 10);
+}
+
+TEST_CASE("Time series ring evicts the oldest sample when full", "[time_series_ring]") {
+    time_series_ring_c<int, 2> ring;
+
+    ring.push(100, 5);
+    ring.push(150, 92);
+    ring.push(200, 18);
+
+    REQUIRE(ring.size() == 2);
+    REQUIRE(ring[0].timestamp == 150);
+    REQUIRE(ring.total() == 92 + 18);
+}
+
+TEST_CASE("Empty time series ring has a default mean", "[time_series_ring]") {
+    time_series_ring_c<int, 4> ring;
+
+    ring.push(100, 5);
+    ring.reset();
+
+    REQUIRE(ring.empty());
+    REQUIRE(ring.mean_since(0) == 0);
+    REQUIRE(ring.count_since(0) == 0);
 }
 
 TEST_CASE("queue is empty after clear()", "[queue]"){